@@ -0,0 +1,170 @@
+/**
+  ******************************************************************************
+  * @file           : Bezier.h
+  * @author         : AliceRemake
+  * @brief          : Bezier Decomposition And Subdivision
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef BEZIER_H
+#define BEZIER_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+
+namespace NURBS
+{
+
+/// @brief Split A Clamped B-Spline Into Its Bezier Segments, One Per Nonempty Knot Span. A5.6 In The NURBS Book.
+///
+/// Point Is Any Type Supporting Point * T And Point + Point, e.g. Homogeneous Control Points.
+///
+template <typename T, typename Point>
+std::vector<std::vector<Point>> DecomposeBezier(const size_t degree, const std::vector<T>& knots, const std::vector<Point>& control_points)
+{
+    assert(knots.size() == control_points.size() + degree + 1);
+
+    const size_t m = knots.size() - 1;
+    std::vector<std::vector<Point>> segments(1, std::vector<Point>(control_points.begin(), control_points.begin() + (long long)degree + 1));
+    std::vector<T> alphas(degree + 1);
+
+    size_t a = degree, b = degree + 1;
+
+    while (b < m)
+    {
+        const size_t i = b;
+        while (b < m && knots[b+1] == knots[b])
+        {
+            ++b;
+        }
+        const size_t mult = b - i + 1;
+        const size_t nb = segments.size() - 1;
+
+        if (b < m)
+        {
+            assert(mult <= degree);
+            segments.emplace_back(degree + 1);
+        }
+
+        // Insert knots[b] Until Its Multiplicity Is degree. The Last Point Of Each Step Starts The Next Segment.
+        if (mult < degree)
+        {
+            const T numer = knots[b] - knots[a];
+            for (size_t j = degree; j > mult; --j)
+            {
+                alphas[j-mult-1] = numer / (knots[a+j] - knots[a]);
+            }
+            const size_t r = degree - mult;
+            for (size_t j = 1; j <= r; ++j)
+            {
+                const size_t save = r - j;
+                const size_t s = mult + j;
+                for (size_t k = degree; k >= s; --k)
+                {
+                    segments[nb][k] = segments[nb][k] * alphas[k-s] + segments[nb][k-1] * (T(1) - alphas[k-s]);
+                }
+                if (b < m)
+                {
+                    segments[nb+1][save] = segments[nb][degree];
+                }
+            }
+        }
+
+        if (b < m)
+        {
+            for (size_t k = degree - mult; k <= degree; ++k)
+            {
+                segments[nb+1][k] = control_points[b-degree+k];
+            }
+            a = b;
+            ++b;
+        }
+    }
+
+    return segments;
+}
+
+/// @brief Bezier Patches Of A Clamped Surface, One Per Nonempty Knot Span Tile, In Homogeneous Coordinates And
+/// Precision T. Patch s * num_v_spans + r Covers The s-th Nonempty u Span And r-th Nonempty v Span And Holds
+/// (degree_u + 1) x (degree_v + 1) Points, Row Major, Point (k, l) At k * (degree_v + 1) + l.
+template <typename T>
+std::vector<std::vector<glm::vec<4, T>>> DecomposeBezier(const tinynurbs::RationalSurface<float>& srf)
+{
+    using Point = glm::vec<4, T>;
+
+    const size_t degree_u = srf.degree_u;
+    const size_t degree_v = srf.degree_v;
+    const std::vector<T> knots_u(srf.knots_u.begin(), srf.knots_u.end());
+    const std::vector<T> knots_v(srf.knots_v.begin(), srf.knots_v.end());
+    const size_t rows = srf.control_points.rows();
+    const size_t cols = srf.control_points.cols();
+
+    // Decompose Every Row Along v: rows_v[i][r] Are The degree_v + 1 Bezier Points Of Row i On v Span r.
+    std::vector<std::vector<std::vector<Point>>> rows_v(rows);
+    std::vector<Point> row(cols);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            const T w = srf.weights(i, j);
+            row[j] = Point(glm::vec<3, T>(srf.control_points(i, j)) * w, w);
+        }
+        rows_v[i] = DecomposeBezier(degree_v, knots_v, row);
+    }
+
+    const size_t num_v_spans = rows_v.front().size();
+    std::vector<std::vector<Point>> patches;
+    std::vector<Point> column(rows);
+
+    for (size_t r = 0; r < num_v_spans; ++r)
+    {
+        // Then Every Column Of Those Along u.
+        for (size_t l = 0; l <= degree_v; ++l)
+        {
+            for (size_t i = 0; i < rows; ++i)
+            {
+                column[i] = rows_v[i][r][l];
+            }
+            const auto segments = DecomposeBezier(degree_u, knots_u, column);
+
+            if (patches.empty())
+            {
+                patches.assign(segments.size() * num_v_spans, std::vector<Point>((degree_u + 1) * (degree_v + 1)));
+            }
+            for (size_t s = 0; s < segments.size(); ++s)
+            {
+                for (size_t k = 0; k <= degree_u; ++k)
+                {
+                    patches[s * num_v_spans + r][k * (degree_v + 1) + l] = segments[s][k];
+                }
+            }
+        }
+    }
+
+    return patches;
+}
+
+/// @brief Split A Bezier Curve At t = 1/2 By de Casteljau's Algorithm. points[i * stride] Are The Control Points,
+/// Overwritten By The Left Half; The Right Half Goes To right[i * stride].
+template <typename Point>
+void SplitBezier(Point* points, Point* right, const size_t degree, const size_t stride)
+{
+    right[degree * stride] = points[degree * stride];
+    for (size_t r = 1; r <= degree; ++r)
+    {
+        for (size_t i = degree; i >= r; --i)
+        {
+            points[i * stride] = (points[i * stride] + points[(i - 1) * stride]) * (typename Point::value_type)0.5;
+        }
+        right[(degree - r) * stride] = points[degree * stride];
+    }
+}
+
+}
+
+#endif //BEZIER_H
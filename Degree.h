@@ -0,0 +1,650 @@
+/**
+  ******************************************************************************
+  * @file           : Degree.h
+  * @author         : AliceRemake
+  * @brief          : Degree Elevation And Degree Reduction Of Curves And Surfaces
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef DEGREE_H
+#define DEGREE_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+
+namespace NURBS
+{
+
+/// @brief Knot Vector After Raising The Degree By t: Every Distinct Knot Gains t Multiplicity.
+inline std::vector<float> ElevatedKnots(const std::span<const float> knots, const size_t t)
+{
+    std::vector<float> elevated;
+    for (size_t i = 0; i < knots.size(); ++i)
+    {
+        elevated.push_back(knots[i]);
+        if (i + 1 == knots.size() || knots[i+1] != knots[i])
+        {
+            elevated.insert(elevated.end(), t, knots[i]);
+        }
+    }
+    return elevated;
+}
+
+/// @brief Knot Vector After Lowering The Degree By One: Every Distinct Knot Loses One Multiplicity.
+inline std::vector<float> ReducedKnots(const std::span<const float> knots)
+{
+    std::vector<float> reduced;
+    for (size_t i = 0; i + 1 < knots.size(); ++i)
+    {
+        if (knots[i+1] == knots[i])
+        {
+            reduced.push_back(knots[i]);
+        }
+    }
+    return reduced;
+}
+
+/// @brief Raise The Degree Of A Clamped B-Spline By t. A5.9 In The NURBS Book.
+///
+/// Control Point i Is control_points[i * stride], Elevated Point i Is Written To elevated[i * elevated_stride], Which
+/// Must Hold ElevatedKnots(knots, t).size() - degree - t - 1 Points. Point Is Any Type Supporting Point * float And
+/// Point + Point, e.g. Homogeneous Control Points.
+///
+template <typename Point>
+void ElevateDegree(const size_t degree, const std::span<const float> knots, const Point* control_points, const size_t stride,
+                   const size_t t, Point* elevated, const size_t elevated_stride)
+{
+    using Index = long long;
+
+    const auto Pw = [&](const Index i) -> const Point& { return control_points[i * (Index)stride]; };
+    const auto Qw = [&](const Index i) -> Point& { return elevated[i * (Index)elevated_stride]; };
+    const auto U = [&](const Index i) { return knots[i]; };
+
+    const Index p = (Index)degree;
+    const Index m = (Index)knots.size() - 1;
+    const Index ph = p + (Index)t;
+    const Index ph2 = ph / 2;
+
+    if (t == 0)
+    {
+        for (Index i = 0; i < m - p; ++i)
+        {
+            Qw(i) = Pw(i);
+        }
+        return;
+    }
+
+    // Coefficients Of Bezier Degree Elevation, bezalfs[i * (p + 1) + j].
+    std::vector<float> bezalfs((ph + 1) * (p + 1), 0.0f);
+    const auto bezalf = [&](const Index i, const Index j) -> float& { return bezalfs[i * (p + 1) + j]; };
+    bezalf(0, 0) = bezalf(ph, p) = 1.0f;
+    for (Index i = 1; i <= ph2; ++i)
+    {
+        const float inv = 1.0f / (float)Binomial(i, ph);
+        for (Index j = std::max((Index)0, i - (Index)t); j <= std::min(p, i); ++j)
+        {
+            bezalf(i, j) = inv * (float)Binomial(j, p) * (float)Binomial(i - j, t);
+        }
+    }
+    for (Index i = ph2 + 1; i <= ph - 1; ++i)
+    {
+        for (Index j = std::max((Index)0, i - (Index)t); j <= std::min(p, i); ++j)
+        {
+            bezalf(i, j) = bezalf(ph - i, p - j);
+        }
+    }
+
+    std::vector<float> Uh(ElevatedKnots(knots, t).size());
+    std::vector<Point> bpts(p + 1), ebpts(ph + 1), next_bpts(std::max(p - 1, (Index)1));
+    std::vector<float> alfs(std::max(p - 1, (Index)1));
+
+    Index kind = ph + 1, r = -1, a = p, b = p + 1, cind = 1;
+    float ua = U(0);
+
+    Qw(0) = Pw(0);
+    for (Index i = 0; i <= ph; ++i)
+    {
+        Uh[i] = ua;
+    }
+    for (Index i = 0; i <= p; ++i)
+    {
+        bpts[i] = Pw(i);
+    }
+
+    while (b < m)
+    {
+        const Index i = b;
+        while (b < m && U(b) == U(b+1))
+        {
+            ++b;
+        }
+        const Index mul = b - i + 1;
+        const float ub = U(b);
+        const Index oldr = r;
+        r = p - mul;
+        const Index lbz = oldr > 0 ? (oldr + 2) / 2 : 1;
+        const Index rbz = r > 0 ? ph - (r + 1) / 2 : ph;
+
+        // Insert ub r Times To Split Off The Bezier Segment [ua, ub].
+        if (r > 0)
+        {
+            const float numer = ub - ua;
+            for (Index k = p; k > mul; --k)
+            {
+                alfs[k-mul-1] = numer / (U(a+k) - ua);
+            }
+            for (Index j = 1; j <= r; ++j)
+            {
+                const Index save = r - j;
+                const Index s = mul + j;
+                for (Index k = p; k >= s; --k)
+                {
+                    bpts[k] = bpts[k] * alfs[k-s] + bpts[k-1] * (1.0f - alfs[k-s]);
+                }
+                next_bpts[save] = bpts[p];
+            }
+        }
+
+        // Degree Elevate The Bezier Segment.
+        for (Index l = lbz; l <= ph; ++l)
+        {
+            ebpts[l] = Point(0);
+            for (Index j = std::max((Index)0, l - (Index)t); j <= std::min(p, l); ++j)
+            {
+                ebpts[l] += bpts[j] * bezalf(l, j);
+            }
+        }
+
+        // Remove ua oldr Times To Restore The Original Continuity.
+        if (oldr > 1)
+        {
+            Index first = kind - 2, last = kind;
+            const float den = ub - ua;
+            const float bet = (ub - Uh[kind-1]) / den;
+            for (Index tr = 1; tr < oldr; ++tr)
+            {
+                Index l = first, j = last, kj = j - kind + 1;
+                while (j - l > tr)
+                {
+                    if (l < cind)
+                    {
+                        const float alf = (ub - Uh[l]) / (ua - Uh[l]);
+                        Qw(l) = Qw(l) * alf + Qw(l-1) * (1.0f - alf);
+                    }
+                    if (j >= lbz)
+                    {
+                        if (j - tr <= kind - ph + oldr)
+                        {
+                            const float gam = (ub - Uh[j-tr]) / den;
+                            ebpts[kj] = ebpts[kj] * gam + ebpts[kj+1] * (1.0f - gam);
+                        }
+                        else
+                        {
+                            ebpts[kj] = ebpts[kj] * bet + ebpts[kj+1] * (1.0f - bet);
+                        }
+                    }
+                    ++l;
+                    --j;
+                    --kj;
+                }
+                --first;
+                ++last;
+            }
+        }
+
+        if (a != p)
+        {
+            for (Index l = 0; l < ph - oldr; ++l)
+            {
+                Uh[kind++] = ua;
+            }
+        }
+        for (Index j = lbz; j <= rbz; ++j)
+        {
+            Qw(cind++) = ebpts[j];
+        }
+
+        if (b < m)
+        {
+            for (Index j = 0; j < r; ++j)
+            {
+                bpts[j] = next_bpts[j];
+            }
+            for (Index j = r; j <= p; ++j)
+            {
+                bpts[j] = Pw(b-p+j);
+            }
+            a = b;
+            ++b;
+            ua = ub;
+        }
+    }
+}
+
+/// @brief Lower The Degree Of A Bezier Segment By One, (5.41)-(5.46) In The NURBS Book.
+/// @return Bound Of The Distance Between The Segments.
+template <typename Point>
+float ReduceBezierDegree(const std::span<const Point> bpts, const std::span<Point> rbpts)
+{
+    const size_t p = bpts.size() - 1;
+    const size_t r = (p - 1) / 2;
+    assert(p >= 2 && rbpts.size() == p);
+
+    const auto alpha = [p](const size_t i) { return (float)i / (float)p; };
+
+    rbpts[0] = bpts[0];
+    rbpts[p-1] = bpts[p];
+
+    const size_t left = p % 2 == 0 ? r : r - 1;
+    for (size_t i = 1; i <= left; ++i)
+    {
+        rbpts[i] = (bpts[i] - rbpts[i-1] * alpha(i)) / (1.0f - alpha(i));
+    }
+    for (size_t i = p - 2; i > r; --i)
+    {
+        rbpts[i] = (bpts[i+1] - rbpts[i+1] * (1.0f - alpha(i+1))) / alpha(i+1);
+    }
+
+    if (p % 2 == 0)
+    {
+        return glm::distance(bpts[r+1], (rbpts[r] + rbpts[r+1]) * 0.5f);
+    }
+
+    const Point left_point = (bpts[r] - rbpts[r-1] * alpha(r)) / (1.0f - alpha(r));
+    const Point right_point = (bpts[r+1] - rbpts[r+1] * (1.0f - alpha(r+1))) / alpha(r+1);
+    rbpts[r] = (left_point + right_point) * 0.5f;
+    return 0.5f * (1.0f - alpha(r)) * glm::distance(left_point, right_point);
+}
+
+/// @brief Lower The Degree Of A Clamped B-Spline By One If It Stays Within tolerance. A5.11 In The NURBS Book.
+///
+/// Layout As In ElevateDegree, reduced Must Hold ReducedKnots(knots).size() - degree Points.
+///
+/// @return Bound Of The Deviation, Or Infinity If It Exceeds tolerance (reduced Is Then Unspecified).
+template <typename Point>
+float ReduceDegree(const size_t degree, const std::span<const float> knots, const Point* control_points, const size_t stride,
+                   const float tolerance, Point* reduced, const size_t reduced_stride)
+{
+    using Index = long long;
+    constexpr float Failed = std::numeric_limits<float>::infinity();
+
+    assert(degree >= 2);
+
+    const auto Qw = [&](const Index i) -> const Point& { return control_points[i * (Index)stride]; };
+    const auto Pw = [&](const Index i) -> Point& { return reduced[i * (Index)reduced_stride]; };
+    const auto U = [&](const Index i) { return knots[i]; };
+
+    const Index p = (Index)degree;
+    const Index m = (Index)knots.size() - 1;
+    const Index ph = p - 1;
+
+    std::vector<float> Uh(ReducedKnots(knots).size());
+    std::vector<Point> bpts(p + 1), next_bpts(p - 1), rbpts(p);
+    std::vector<float> alphas(p - 1);
+    // Accumulated Error Bound Of Each Knot Span.
+    std::vector<float> e(m + 1, 0.0f);
+
+    Index kind = ph + 1, r = -1, a = p, b = p + 1, cind = 1;
+
+    Pw(0) = Qw(0);
+    for (Index i = 0; i <= ph; ++i)
+    {
+        Uh[i] = U(0);
+    }
+    for (Index i = 0; i <= p; ++i)
+    {
+        bpts[i] = Qw(i);
+    }
+
+    while (b < m)
+    {
+        Index i = b;
+        while (b < m && U(b) == U(b+1))
+        {
+            ++b;
+        }
+        const Index mult = b - i + 1;
+        const Index oldr = r;
+        r = p - mult;
+        const Index lbz = oldr > 0 ? (oldr + 2) / 2 : 1;
+
+        // Insert U(b) r Times To Split Off The Bezier Segment [U(a), U(b)].
+        if (r > 0)
+        {
+            const float numer = U(b) - U(a);
+            for (Index k = p; k > mult; --k)
+            {
+                alphas[k-mult-1] = numer / (U(a+k) - U(a));
+            }
+            for (Index j = 1; j <= r; ++j)
+            {
+                const Index save = r - j;
+                const Index s = mult + j;
+                for (Index k = p; k >= s; --k)
+                {
+                    bpts[k] = bpts[k] * alphas[k-s] + bpts[k-1] * (1.0f - alphas[k-s]);
+                }
+                next_bpts[save] = bpts[p];
+            }
+        }
+
+        e[a] += ReduceBezierDegree<Point>(bpts, rbpts);
+        if (e[a] > tolerance)
+        {
+            return Failed;
+        }
+
+        // Remove U(a) oldr Times, Accumulating The Removal Error On The Affected Spans.
+        if (oldr > 0)
+        {
+            Index first = kind, last = kind;
+            for (Index k = 0; k < oldr; ++k)
+            {
+                i = first;
+                Index j = last, kj = j - kind;
+                while (j - i > k)
+                {
+                    const float alfa = (U(a) - Uh[i-1]) / (U(b) - Uh[i-1]);
+                    const float beta = (U(a) - Uh[j-k-1]) / (U(b) - Uh[j-k-1]);
+                    Pw(i-1) = (Pw(i-1) - Pw(i-2) * (1.0f - alfa)) / alfa;
+                    rbpts[kj] = (rbpts[kj] - rbpts[kj+1] * beta) / (1.0f - beta);
+                    ++i;
+                    --j;
+                    --kj;
+                }
+
+                float error;
+                if (j - i < k)
+                {
+                    error = glm::distance(Pw(i-2), rbpts[kj+1]);
+                }
+                else
+                {
+                    const float delta = (U(a) - Uh[i-1]) / (U(b) - Uh[i-1]);
+                    error = glm::distance(Pw(i-1), rbpts[kj+1] * delta + Pw(i-2) * (1.0f - delta));
+                }
+
+                const Index K = a + oldr - k;
+                const Index q = (2 * p - k + 1) / 2;
+                for (Index l = std::max(K - q, (Index)0); l <= a; ++l)
+                {
+                    e[l] += error;
+                    if (e[l] > tolerance)
+                    {
+                        return Failed;
+                    }
+                }
+                --first;
+                ++last;
+            }
+            cind = i - 1;
+        }
+
+        if (a != p)
+        {
+            for (Index l = 0; l < ph - oldr; ++l)
+            {
+                Uh[kind++] = U(a);
+            }
+        }
+        for (Index l = lbz; l <= ph; ++l)
+        {
+            Pw(cind++) = rbpts[l];
+        }
+
+        if (b < m)
+        {
+            for (Index l = 0; l < r; ++l)
+            {
+                bpts[l] = next_bpts[l];
+            }
+            for (Index l = r; l <= p; ++l)
+            {
+                bpts[l] = Qw(b-p+l);
+            }
+            a = b;
+            ++b;
+        }
+    }
+
+    return *std::ranges::max_element(e);
+}
+
+namespace internal
+{
+
+inline glm::vec4 Homogeneous(const glm::vec3& point, const float weight)
+{
+    return glm::vec4(point * weight, weight);
+}
+
+/// @brief Tolerance In Homogeneous Space Guaranteeing tolerance In Euclidean Space, (5.30) In The NURBS Book.
+inline float HomogeneousTolerance(const float tolerance, const std::span<const float> weights, const std::span<const glm::vec3> control_points)
+{
+    if (std::ranges::all_of(weights, [](const float w) { return w == 1.0f; }))
+    {
+        return tolerance;
+    }
+    float max_length = 0.0f;
+    for (const auto& point : control_points)
+    {
+        max_length = std::max(max_length, glm::length(point));
+    }
+    return tolerance * std::ranges::min(weights) / (1.0f + max_length);
+}
+
+/// @brief Reduction May Send A Weight To Zero Or Below (e.g. A Semicircle Becomes A Quadratic With A Point At
+/// Infinity), Which Point And Weight Pairs Cannot Hold.
+inline bool PositiveWeights(const std::span<const glm::vec4> homo_control_points)
+{
+    return std::ranges::all_of(homo_control_points, [](const glm::vec4& point) { return point.w > std::numeric_limits<float>::epsilon(); });
+}
+
+inline tinynurbs::RationalCurve<float> FromHomogeneous(const size_t degree, std::vector<float> knots, const std::vector<glm::vec4>& homo_control_points)
+{
+    tinynurbs::RationalCurve<float> crv;
+    crv.degree = degree;
+    crv.knots = std::move(knots);
+    for (const auto& point : homo_control_points)
+    {
+        crv.control_points.push_back(glm::vec3(point) / point.w);
+        crv.weights.push_back(point.w);
+    }
+    return crv;
+}
+
+inline tinynurbs::array2<glm::vec4> Homogeneous(const tinynurbs::RationalSurface<float>& srf)
+{
+    tinynurbs::array2<glm::vec4> homo_control_points(srf.control_points.rows(), srf.control_points.cols());
+    for (size_t i = 0; i < srf.control_points.rows(); ++i)
+    {
+        for (size_t j = 0; j < srf.control_points.cols(); ++j)
+        {
+            homo_control_points(i, j) = Homogeneous(srf.control_points(i, j), srf.weights(i, j));
+        }
+    }
+    return homo_control_points;
+}
+
+inline void FromHomogeneous(const tinynurbs::array2<glm::vec4>& homo_control_points, tinynurbs::RationalSurface<float>& srf)
+{
+    srf.control_points.resize(homo_control_points.rows(), homo_control_points.cols());
+    srf.weights.resize(homo_control_points.rows(), homo_control_points.cols());
+    for (size_t i = 0; i < homo_control_points.rows(); ++i)
+    {
+        for (size_t j = 0; j < homo_control_points.cols(); ++j)
+        {
+            srf.control_points(i, j) = glm::vec3(homo_control_points(i, j)) / homo_control_points(i, j).w;
+            srf.weights(i, j) = homo_control_points(i, j).w;
+        }
+    }
+}
+
+/// @brief Apply A Curve Operation To Every Column (along_u) Or Row Of points In Place. operation(points, stride, out,
+/// out_stride) Writes One Line Of The size Result Rows Or Columns.
+template <typename Operation>
+tinynurbs::array2<glm::vec4> ForEachLine(const tinynurbs::array2<glm::vec4>& points, const bool along_u, const size_t size, const Operation& operation)
+{
+    const size_t rows = points.rows(), cols = points.cols();
+    tinynurbs::array2<glm::vec4> result(along_u ? size : rows, along_u ? cols : size);
+    for (size_t line = 0; line < (along_u ? cols : rows); ++line)
+    {
+        if (along_u)
+        {
+            operation(points.data() + line, cols, result.data() + line, cols);
+        }
+        else
+        {
+            operation(points.data() + line * cols, 1, result.data() + line * size, 1);
+        }
+    }
+    return result;
+}
+
+}
+
+/// @brief Raise The Degree Of crv By t.
+inline tinynurbs::RationalCurve<float> ElevateDegree(const tinynurbs::RationalCurve<float>& crv, const size_t t)
+{
+    std::vector<glm::vec4> homo_control_points(crv.control_points.size());
+    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    {
+        homo_control_points[i] = internal::Homogeneous(crv.control_points[i], crv.weights[i]);
+    }
+
+    auto knots = ElevatedKnots(crv.knots, t);
+    std::vector<glm::vec4> elevated(knots.size() - crv.degree - t - 1);
+    ElevateDegree(crv.degree, crv.knots, homo_control_points.data(), 1, t, elevated.data(), 1);
+
+    return internal::FromHomogeneous(crv.degree + t, std::move(knots), elevated);
+}
+
+/// @brief Lower The Degree Of crv By One, Or Nothing If That Moves The Curve More Than tolerance.
+inline std::optional<tinynurbs::RationalCurve<float>> ReduceDegree(const tinynurbs::RationalCurve<float>& crv, const float tolerance)
+{
+    if (crv.degree < 2)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<glm::vec4> homo_control_points(crv.control_points.size());
+    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    {
+        homo_control_points[i] = internal::Homogeneous(crv.control_points[i], crv.weights[i]);
+    }
+
+    auto knots = ReducedKnots(crv.knots);
+    std::vector<glm::vec4> reduced(knots.size() - crv.degree);
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, crv.weights, crv.control_points);
+    if (ReduceDegree(crv.degree, crv.knots, homo_control_points.data(), 1, homo_tolerance, reduced.data(), 1) > homo_tolerance ||
+        !internal::PositiveWeights(reduced))
+    {
+        return std::nullopt;
+    }
+
+    return internal::FromHomogeneous(crv.degree - 1, std::move(knots), reduced);
+}
+
+/// @brief Raise The Degrees Of srf By t_u And t_v.
+inline tinynurbs::RationalSurface<float> ElevateDegree(const tinynurbs::RationalSurface<float>& srf, const size_t t_u, const size_t t_v)
+{
+    tinynurbs::RationalSurface<float> result;
+    result.degree_u = srf.degree_u + t_u;
+    result.degree_v = srf.degree_v + t_v;
+    result.knots_u = ElevatedKnots(srf.knots_u, t_u);
+    result.knots_v = ElevatedKnots(srf.knots_v, t_v);
+
+    auto homo_control_points = internal::ForEachLine(internal::Homogeneous(srf), true, result.knots_u.size() - result.degree_u - 1,
+        [&](const glm::vec4* points, const size_t stride, glm::vec4* elevated, const size_t elevated_stride)
+        {
+            ElevateDegree(srf.degree_u, srf.knots_u, points, stride, t_u, elevated, elevated_stride);
+        });
+    homo_control_points = internal::ForEachLine(homo_control_points, false, result.knots_v.size() - result.degree_v - 1,
+        [&](const glm::vec4* points, const size_t stride, glm::vec4* elevated, const size_t elevated_stride)
+        {
+            ElevateDegree(srf.degree_v, srf.knots_v, points, stride, t_v, elevated, elevated_stride);
+        });
+
+    internal::FromHomogeneous(homo_control_points, result);
+    return result;
+}
+
+/// @brief Lower The Degree Of srf In u (along_u) Or v By One, Or Nothing If That Moves The Surface More Than tolerance.
+/// Every Row Or Column Is Reduced Over The Same Knot Vector, So Each Staying Within tolerance Bounds The Surface.
+inline std::optional<tinynurbs::RationalSurface<float>> ReduceDegree(const tinynurbs::RationalSurface<float>& srf, const bool along_u, const float tolerance)
+{
+    const size_t degree = along_u ? srf.degree_u : srf.degree_v;
+    const auto& knots = along_u ? srf.knots_u : srf.knots_v;
+    if (degree < 2)
+    {
+        return std::nullopt;
+    }
+
+    tinynurbs::RationalSurface<float> result = srf;
+    (along_u ? result.degree_u : result.degree_v) = degree - 1;
+    (along_u ? result.knots_u : result.knots_v) = ReducedKnots(knots);
+
+    const auto weights = std::span<const float>(srf.weights.data(), srf.weights.rows() * srf.weights.cols());
+    const auto control_points = std::span<const glm::vec3>(srf.control_points.data(), srf.control_points.rows() * srf.control_points.cols());
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, weights, control_points);
+
+    bool reducible = true;
+    const auto homo_control_points = internal::ForEachLine(internal::Homogeneous(srf), along_u, ReducedKnots(knots).size() - degree,
+        [&](const glm::vec4* points, const size_t stride, glm::vec4* reduced, const size_t reduced_stride)
+        {
+            reducible = reducible && ReduceDegree(degree, knots, points, stride, homo_tolerance, reduced, reduced_stride) <= homo_tolerance;
+        });
+    if (!reducible || !internal::PositiveWeights(std::span(homo_control_points.data(), homo_control_points.rows() * homo_control_points.cols())))
+    {
+        return std::nullopt;
+    }
+
+    internal::FromHomogeneous(homo_control_points, result);
+    return result;
+}
+
+/// @brief Bring crv To degree, Raising It Exactly Or Lowering It Step By Step Within tolerance Overall.
+inline std::optional<tinynurbs::RationalCurve<float>> ToDegree(const tinynurbs::RationalCurve<float>& crv, const size_t degree, const float tolerance)
+{
+    if (degree >= crv.degree)
+    {
+        return ElevateDegree(crv, degree - crv.degree);
+    }
+
+    // The Deviations Of The Steps Add Up, So Each Gets An Equal Share.
+    const float step_tolerance = tolerance / (float)(crv.degree - degree);
+    std::optional<tinynurbs::RationalCurve<float>> result = crv;
+    while (result && result->degree > degree)
+    {
+        result = ReduceDegree(*result, step_tolerance);
+    }
+    return result;
+}
+
+/// @brief Bring srf To degree_u x degree_v, Raising It Exactly Or Lowering It Step By Step Within tolerance Overall.
+inline std::optional<tinynurbs::RationalSurface<float>> ToDegree(const tinynurbs::RationalSurface<float>& srf, const size_t degree_u, const size_t degree_v, const float tolerance)
+{
+    const size_t steps = (srf.degree_u > degree_u ? srf.degree_u - degree_u : 0) + (srf.degree_v > degree_v ? srf.degree_v - degree_v : 0);
+    const float step_tolerance = steps > 0 ? tolerance / (float)steps : tolerance;
+
+    std::optional<tinynurbs::RationalSurface<float>> result = ElevateDegree(srf, degree_u > srf.degree_u ? degree_u - srf.degree_u : 0,
+                                                                            degree_v > srf.degree_v ? degree_v - srf.degree_v : 0);
+    while (result && result->degree_u > degree_u)
+    {
+        result = ReduceDegree(*result, true, step_tolerance);
+    }
+    while (result && result->degree_v > degree_v)
+    {
+        result = ReduceDegree(*result, false, step_tolerance);
+    }
+    return result;
+}
+
+}
+
+#endif //DEGREE_H
@@ -0,0 +1,184 @@
+/**
+  ******************************************************************************
+  * @file           : EditableSurface.h
+  * @author         : AliceRemake
+  * @brief          : Surface With Incrementally Updated Tessellation
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef EDITABLE_SURFACE_H
+#define EDITABLE_SURFACE_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Tessellation.h>
+
+namespace NURBS
+{
+
+/// @brief A Surface Whose Tessellation Is Cached Per Nonempty Knot Span Tile.
+///
+/// Control Point (i, j) Only Affects u Spans [i, i+degree_u] And v Spans [j, j+degree_v], So Editing It Marks At
+/// Most (degree_u + 1) x (degree_v + 1) Tiles Dirty. Update() Re-Evaluates Only Those Tiles.
+///
+class EditableSurface
+{
+public:
+    explicit EditableSurface(tinynurbs::RationalSurface<float> srf, const size_t resolution = 8)
+        : srf_(std::move(srf)), resolution_(resolution)
+    {
+        assert(resolution_ > 0);
+        assert(srf_.control_points.rows() == srf_.weights.rows() && srf_.control_points.cols() == srf_.weights.cols());
+
+        u_spans_ = KnotSpans(srf_.degree_u, srf_.knots_u);
+        v_spans_ = KnotSpans(srf_.degree_v, srf_.knots_v);
+
+        tiles_.resize(u_spans_.size() * v_spans_.size());
+        dirty_tiles_.assign(tiles_.size(), false);
+
+        for (size_t a = 0; a < u_spans_.size(); ++a)
+        {
+            for (size_t b = 0; b < v_spans_.size(); ++b)
+            {
+                SurfaceTile& tile = tiles_[a * v_spans_.size() + b];
+                tile.u_span = u_spans_[a];
+                tile.v_span = v_spans_[b];
+                tile.resolution = resolution_;
+                TessellateTile(srf_, tile);
+                bounding_box_.Expand(tile.bounding_box);
+            }
+        }
+    }
+
+    [[nodiscard]] const tinynurbs::RationalSurface<float>& Surface() const noexcept
+    {
+        return srf_;
+    }
+
+    [[nodiscard]] size_t Resolution() const noexcept
+    {
+        return resolution_;
+    }
+
+    /// @brief Number Of Tiles Along u And v.
+    [[nodiscard]] size_t Rows() const noexcept
+    {
+        return u_spans_.size();
+    }
+
+    [[nodiscard]] size_t Cols() const noexcept
+    {
+        return v_spans_.size();
+    }
+
+    /// @brief Tiles In Row Major Order, Tile (a, b) Covers The a-th Nonempty u Span And The b-th Nonempty v Span.
+    /// Stale Until Update() Is Called After An Edit.
+    [[nodiscard]] const std::vector<SurfaceTile>& Tiles() const noexcept
+    {
+        return tiles_;
+    }
+
+    [[nodiscard]] const SurfaceTile& Tile(const size_t a, const size_t b) const noexcept
+    {
+        assert(a < Rows() && b < Cols());
+        return tiles_[a * v_spans_.size() + b];
+    }
+
+    [[nodiscard]] const BoundingBox& Bounds() const noexcept
+    {
+        return bounding_box_;
+    }
+
+    [[nodiscard]] bool Dirty() const noexcept
+    {
+        return !dirty_control_points_.empty();
+    }
+
+    void SetControlPoint(const size_t i, const size_t j, const glm::vec3& control_point)
+    {
+        srf_.control_points(i, j) = control_point;
+        dirty_control_points_.emplace_back(i, j);
+    }
+
+    void SetWeight(const size_t i, const size_t j, const float weight)
+    {
+        assert(weight > 0.0f);
+        srf_.weights(i, j) = weight;
+        dirty_control_points_.emplace_back(i, j);
+    }
+
+    /// @brief Re-Evaluate Every Tile Touched By An Edit Since The Last Update.
+    /// @return Number Of Re-Evaluated Tiles.
+    size_t Update()
+    {
+        if (dirty_control_points_.empty())
+        {
+            return 0;
+        }
+
+        std::vector<size_t> dirty;
+
+        for (const auto& [i, j] : dirty_control_points_)
+        {
+            const auto [a_first, a_last] = AffectedSpans(u_spans_, srf_.degree_u, i);
+            const auto [b_first, b_last] = AffectedSpans(v_spans_, srf_.degree_v, j);
+
+            for (size_t a = a_first; a < a_last; ++a)
+            {
+                for (size_t b = b_first; b < b_last; ++b)
+                {
+                    const size_t index = a * v_spans_.size() + b;
+                    if (!dirty_tiles_[index])
+                    {
+                        dirty_tiles_[index] = true;
+                        dirty.push_back(index);
+                    }
+                }
+            }
+        }
+
+        for (const size_t index : dirty)
+        {
+            TessellateTile(srf_, tiles_[index]);
+            dirty_tiles_[index] = false;
+        }
+
+        // Union Of Cached Tile Boxes. No Surface Evaluation Involved.
+        bounding_box_ = BoundingBox();
+        for (const SurfaceTile& tile : tiles_)
+        {
+            bounding_box_.Expand(tile.bounding_box);
+        }
+
+        dirty_control_points_.clear();
+
+        return dirty.size();
+    }
+
+private:
+    /// @brief Range [first, last) Into spans Of The Nonempty Spans In [index, index + degree].
+    static std::pair<size_t, size_t> AffectedSpans(const std::vector<size_t>& spans, const size_t degree, const size_t index) noexcept
+    {
+        const auto first = std::lower_bound(spans.begin(), spans.end(), index);
+        const auto last = std::upper_bound(first, spans.end(), index + degree);
+        return { (size_t)(first - spans.begin()), (size_t)(last - spans.begin()) };
+    }
+
+    tinynurbs::RationalSurface<float> srf_;
+    size_t resolution_;
+    std::vector<size_t> u_spans_;
+    std::vector<size_t> v_spans_;
+    std::vector<SurfaceTile> tiles_;
+    std::vector<bool> dirty_tiles_;
+    std::vector<std::pair<size_t, size_t>> dirty_control_points_;
+    BoundingBox bounding_box_;
+};
+
+}
+
+#endif //EDITABLE_SURFACE_H
@@ -0,0 +1,500 @@
+/**
+  ******************************************************************************
+  * @file           : Fitting.h
+  * @author         : AliceRemake
+  * @brief          : Curve And Surface Interpolation And Least Squares Approximation
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef FITTING_H
+#define FITTING_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Parallel.h>
+
+namespace NURBS
+{
+
+/// @brief Square Matrix Storing Only Diagonals [-lower, upper], Row Major: (i, j) At i * (lower + upper + 1) + j - i + lower.
+///
+/// Factor Is LU Without Pivoting, O(n * lower * upper). It Is Stable For The Matrices Of Fitting: B-Spline Collocation
+/// Matrices Are Totally Positive And Normal Equations Are Symmetric Positive Definite.
+///
+class BandedMatrix
+{
+public:
+    BandedMatrix(const size_t n, const size_t lower, const size_t upper)
+        : n_(n), lower_(lower), upper_(upper), data_(n * (lower + upper + 1), 0.0)
+    {}
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return n_;
+    }
+
+    double& operator()(const size_t i, const size_t j) noexcept
+    {
+        assert(i < n_ && j < n_ && j + lower_ >= i && j <= i + upper_);
+        return data_[i * (lower_ + upper_ + 1) + j + lower_ - i];
+    }
+
+    double operator()(const size_t i, const size_t j) const noexcept
+    {
+        assert(i < n_ && j < n_ && j + lower_ >= i && j <= i + upper_);
+        return data_[i * (lower_ + upper_ + 1) + j + lower_ - i];
+    }
+
+    /// @brief In Place LU Factorization. False On A Zero Pivot.
+    bool Factor()
+    {
+        for (size_t k = 0; k < n_; ++k)
+        {
+            const double pivot = (*this)(k, k);
+            if (std::abs(pivot) < std::numeric_limits<double>::min())
+            {
+                return false;
+            }
+            for (size_t i = k + 1; i <= std::min(n_ - 1, k + lower_); ++i)
+            {
+                const double l = ((*this)(i, k) /= pivot);
+                for (size_t j = k + 1; j <= std::min(n_ - 1, k + upper_); ++j)
+                {
+                    (*this)(i, j) -= l * (*this)(k, j);
+                }
+            }
+        }
+        return true;
+    }
+
+    /// @brief Solve In Place With The Factors, b Holds n Right Hand Sides Of Any Vector Type.
+    template <typename Vector>
+    void Solve(const std::span<Vector> b) const
+    {
+        assert(b.size() == n_);
+        for (size_t i = 1; i < n_; ++i)
+        {
+            for (size_t j = i > lower_ ? i - lower_ : 0; j < i; ++j)
+            {
+                b[i] -= (*this)(i, j) * b[j];
+            }
+        }
+        for (size_t i = n_; i-- > 0;)
+        {
+            for (size_t j = i + 1; j <= std::min(n_ - 1, i + upper_); ++j)
+            {
+                b[i] -= (*this)(i, j) * b[j];
+            }
+            b[i] /= (*this)(i, i);
+        }
+    }
+
+private:
+    size_t n_;
+    size_t lower_;
+    size_t upper_;
+    std::vector<double> data_;
+};
+
+enum class Parametrization
+{
+    Uniform,
+    ChordLength,
+    Centripetal,
+};
+
+/// @brief Parameters In [0, 1] For Data points, (9.4)-(9.6) In The NURBS Book. points[i * stride] Is The i-th Point.
+inline std::vector<float> FittingParameters(const glm::vec3* points, const size_t count, const size_t stride, const Parametrization parametrization)
+{
+    assert(count >= 2);
+
+    std::vector<double> distances(count, 0.0);
+    double total = 0.0;
+
+    if (parametrization != Parametrization::Uniform)
+    {
+        for (size_t i = 1; i < count; ++i)
+        {
+            distances[i] = glm::distance(points[i * stride], points[(i - 1) * stride]);
+            if (parametrization == Parametrization::Centripetal)
+            {
+                distances[i] = std::sqrt(distances[i]);
+            }
+            total += distances[i];
+        }
+    }
+
+    std::vector<float> parameters(count);
+    double sum = 0.0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += distances[i];
+        parameters[i] = total > 0.0 ? (float)(sum / total) : (float)i / (float)(count - 1);
+    }
+    parameters.back() = 1.0f;
+
+    return parameters;
+}
+
+inline std::vector<float> FittingParameters(const std::vector<glm::vec3>& points, const Parametrization parametrization)
+{
+    return FittingParameters(points.data(), points.size(), 1, parametrization);
+}
+
+/// @brief Parameters Of A Grid Of Points, Averaged Over Rows (For u) Or Columns (For v), (9.15) In The NURBS Book.
+inline std::vector<float> FittingParameters(const tinynurbs::array2<glm::vec3>& points, const bool along_u, const Parametrization parametrization)
+{
+    const size_t count = along_u ? points.rows() : points.cols();
+    const size_t lines = along_u ? points.cols() : points.rows();
+    const size_t stride = along_u ? points.cols() : 1;
+
+    std::vector<double> sum(count, 0.0);
+    for (size_t line = 0; line < lines; ++line)
+    {
+        const auto parameters = FittingParameters(points.data() + (along_u ? line : line * points.cols()), count, stride, parametrization);
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum[i] += parameters[i];
+        }
+    }
+
+    std::vector<float> parameters(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        parameters[i] = (float)(sum[i] / (double)lines);
+    }
+    parameters.front() = 0.0f;
+    parameters.back() = 1.0f;
+    return parameters;
+}
+
+/// @brief Knots By Averaging Parameters, (9.8) In The NURBS Book. One Control Point Per Parameter.
+/// Degree 0 Has No Window To Average Over, So Its Knots Are The Midpoints Between Neighboring Parameters.
+inline std::vector<float> InterpolationKnots(const size_t degree, const std::vector<float>& parameters)
+{
+    const size_t n = parameters.size() - 1;
+    std::vector<float> knots(n + degree + 2, 0.0f);
+
+    if (degree == 0)
+    {
+        for (size_t j = 1; j <= n; ++j)
+        {
+            knots[j] = (float)(0.5 * ((double)parameters[j-1] + (double)parameters[j]));
+        }
+        knots.back() = 1.0f;
+        return knots;
+    }
+
+    double window = 0.0;
+    for (size_t i = 1; i <= degree; ++i)
+    {
+        window += parameters[i];
+    }
+    for (size_t j = 1; j + degree <= n; ++j)
+    {
+        knots[j+degree] = (float)(window / (double)degree);
+        window += parameters[j+degree] - parameters[j];
+    }
+    std::fill(knots.end() - (long long)degree - 1, knots.end(), 1.0f);
+
+    return knots;
+}
+
+/// @brief Knots Spreading The Parameters Evenly Over num_control_points - degree Spans, (9.68)-(9.69) In The NURBS Book.
+inline std::vector<float> ApproximationKnots(const size_t degree, const std::vector<float>& parameters, const size_t num_control_points)
+{
+    const size_t m = parameters.size() - 1;
+    const size_t n = num_control_points - 1;
+    std::vector<float> knots(n + degree + 2, 0.0f);
+
+    const double d = (double)(m + 1) / (double)(n - degree + 1);
+    for (size_t j = 1; j + degree <= n; ++j)
+    {
+        const auto i = (size_t)((double)j * d);
+        const double alpha = (double)j * d - (double)i;
+        knots[degree+j] = (float)((1.0 - alpha) * parameters[i-1] + alpha * parameters[i]);
+    }
+    std::fill(knots.end() - (long long)degree - 1, knots.end(), 1.0f);
+
+    return knots;
+}
+
+namespace internal
+{
+
+/// @brief Nonzero Basis Functions At Every Parameter: span[k] And basis[k * (degree + 1) + a] = N_{span-degree+a}(u_k).
+struct Collocation
+{
+    Collocation(const size_t degree, const std::vector<float>& knots, const std::vector<float>& parameters)
+        : degree(degree), spans(parameters.size()), basis(parameters.size() * (degree + 1))
+    {
+        EvaluationContext context;
+        for (size_t k = 0; k < parameters.size(); ++k)
+        {
+            spans[k] = FindSpan(degree, knots, parameters[k]);
+            BSplineBasis(context, degree, spans[k], knots, parameters[k], std::span(basis).subspan(k * (degree + 1), degree + 1));
+        }
+    }
+
+    size_t degree;
+    std::vector<size_t> spans;
+    std::vector<float> basis;
+};
+
+/// @brief Factored Collocation Matrix Of A9.1, Shared By Every Row Or Column Of A Surface.
+class Interpolator
+{
+public:
+    Interpolator(const size_t degree, const std::vector<float>& knots, const std::vector<float>& parameters)
+        : matrix_(parameters.size(), degree, degree)
+    {
+        const Collocation collocation(degree, knots, parameters);
+        for (size_t k = 0; k < parameters.size(); ++k)
+        {
+            for (size_t a = 0; a <= degree; ++a)
+            {
+                matrix_(k, collocation.spans[k] - degree + a) = collocation.basis[k * (degree + 1) + a];
+            }
+        }
+        [[maybe_unused]] const bool factored = matrix_.Factor();
+        assert(factored);
+    }
+
+    /// @brief Control Points Interpolating data[k * stride], k In [0, n].
+    template <typename Point>
+    void Solve(const Point* data, const size_t stride, const std::span<glm::dvec3> control_points) const
+    {
+        for (size_t k = 0; k < control_points.size(); ++k)
+        {
+            control_points[k] = glm::dvec3(data[k * stride]);
+        }
+        matrix_.Solve(control_points);
+    }
+
+private:
+    BandedMatrix matrix_;
+};
+
+/// @brief Factored Normal Equations Of A9.7 For num_control_points Control Points, The End Points Interpolated.
+class Approximator
+{
+public:
+    Approximator(const size_t degree, const std::vector<float>& knots, const std::vector<float>& parameters, const size_t num_control_points)
+        : collocation_(degree, knots, parameters), n_(num_control_points - 1),
+          matrix_(num_control_points > 2 ? num_control_points - 2 : 0, degree, degree)
+    {
+        // N^T N Over The Interior Control Points 1..n-1 And Interior Data Points 1..m-1, O(m * degree^2).
+        for (size_t k = 1; k + 1 < parameters.size(); ++k)
+        {
+            for (size_t a = 0; a <= degree; ++a)
+            {
+                const size_t i = collocation_.spans[k] - degree + a;
+                for (size_t b = 0; b <= degree; ++b)
+                {
+                    const size_t j = collocation_.spans[k] - degree + b;
+                    if (i > 0 && i < n_ && j > 0 && j < n_)
+                    {
+                        matrix_(i-1, j-1) += (double)collocation_.basis[k * (degree + 1) + a] * collocation_.basis[k * (degree + 1) + b];
+                    }
+                }
+            }
+        }
+        [[maybe_unused]] const bool factored = matrix_.Size() == 0 || matrix_.Factor();
+        assert(factored);
+    }
+
+    /// @brief Least Squares Control Points For data[k * stride], k In [0, m].
+    template <typename Point>
+    void Solve(const Point* data, const size_t stride, const std::span<glm::dvec3> control_points) const
+    {
+        assert(control_points.size() == n_ + 1);
+
+        const size_t degree = collocation_.degree;
+        const size_t m = collocation_.spans.size() - 1;
+        const glm::dvec3 first(data[0]);
+        const glm::dvec3 last(data[m * stride]);
+
+        std::fill(control_points.begin(), control_points.end(), glm::dvec3(0.0));
+
+        for (size_t k = 1; k < m; ++k)
+        {
+            const size_t span = collocation_.spans[k];
+            const float* basis = collocation_.basis.data() + k * (degree + 1);
+
+            // R_k = Q_k - N_0(u_k) Q_0 - N_n(u_k) Q_m.
+            glm::dvec3 R(data[k * stride]);
+            if (span == degree)
+            {
+                R -= (double)basis[0] * first;
+            }
+            if (span == n_)
+            {
+                R -= (double)basis[degree] * last;
+            }
+
+            for (size_t a = 0; a <= degree; ++a)
+            {
+                const size_t i = span - degree + a;
+                if (i > 0 && i < n_)
+                {
+                    control_points[i] += (double)basis[a] * R;
+                }
+            }
+        }
+
+        if (n_ > 1)
+        {
+            matrix_.Solve(control_points.subspan(1, n_ - 1));
+        }
+        control_points.front() = first;
+        control_points.back() = last;
+    }
+
+private:
+    Collocation collocation_;
+    size_t n_;
+    BandedMatrix matrix_;
+};
+
+}
+
+/// @brief Global Curve Interpolation Through points. A9.1 In The NURBS Book, With A Banded Solve, O(n * degree^2).
+inline tinynurbs::RationalCurve<float> InterpolateCurve(const std::vector<glm::vec3>& points, const size_t degree,
+                                                        const Parametrization parametrization = Parametrization::ChordLength)
+{
+    assert(points.size() > degree);
+
+    const auto parameters = FittingParameters(points, parametrization);
+
+    tinynurbs::RationalCurve<float> crv;
+    crv.degree = degree;
+    crv.knots = InterpolationKnots(degree, parameters);
+
+    std::vector<glm::dvec3> control_points(points.size());
+    internal::Interpolator(degree, crv.knots, parameters).Solve(points.data(), 1, control_points);
+
+    crv.control_points.resize(points.size());
+    std::ranges::transform(control_points, crv.control_points.begin(), [](const glm::dvec3& point) { return glm::vec3(point); });
+    crv.weights.assign(points.size(), 1.0f);
+    return crv;
+}
+
+/// @brief Least Squares Curve Approximation Of points With num_control_points Control Points, Interpolating The End
+/// Points. A9.7 In The NURBS Book, With A Banded Solve Of The Normal Equations, O(m * degree^2).
+inline tinynurbs::RationalCurve<float> ApproximateCurve(const std::vector<glm::vec3>& points, const size_t degree, const size_t num_control_points,
+                                                        const Parametrization parametrization = Parametrization::ChordLength)
+{
+    assert(num_control_points > degree && num_control_points <= points.size());
+
+    const auto parameters = FittingParameters(points, parametrization);
+
+    tinynurbs::RationalCurve<float> crv;
+    crv.degree = degree;
+    crv.knots = ApproximationKnots(degree, parameters, num_control_points);
+
+    std::vector<glm::dvec3> control_points(num_control_points);
+    internal::Approximator(degree, crv.knots, parameters, num_control_points).Solve(points.data(), 1, control_points);
+
+    crv.control_points.resize(num_control_points);
+    std::ranges::transform(control_points, crv.control_points.begin(), [](const glm::dvec3& point) { return glm::vec3(point); });
+    crv.weights.assign(num_control_points, 1.0f);
+    return crv;
+}
+
+namespace internal
+{
+
+/// @brief Fit Every Column Along u With fit_u, Then Every Row Of The Result Along v With fit_v, Rows And Columns In
+/// Parallel. Section 9.2.5 And 9.4.3 In The NURBS Book.
+template <typename Fit>
+tinynurbs::array2<glm::vec3> FitGrid(const tinynurbs::array2<glm::vec3>& points, const Fit& fit_u, const size_t num_u,
+                                     const Fit& fit_v, const size_t num_v, const size_t num_threads)
+{
+    const size_t cols = points.cols();
+
+    // Kept In Double Between The Passes, Rounding To float Only Once At The End.
+    std::vector<glm::dvec3> intermediate(num_u * cols);
+    ParallelFor(0, cols, [&](const size_t j)
+    {
+        std::vector<glm::dvec3> control_points(num_u);
+        fit_u.Solve(points.data() + j, cols, control_points);
+        for (size_t i = 0; i < num_u; ++i)
+        {
+            intermediate[i * cols + j] = control_points[i];
+        }
+    }, num_threads);
+
+    tinynurbs::array2<glm::vec3> result(num_u, num_v);
+    ParallelFor(0, num_u, [&](const size_t i)
+    {
+        std::vector<glm::dvec3> control_points(num_v);
+        fit_v.Solve(intermediate.data() + i * cols, 1, control_points);
+        for (size_t j = 0; j < num_v; ++j)
+        {
+            result(i, j) = glm::vec3(control_points[j]);
+        }
+    }, num_threads);
+
+    return result;
+}
+
+}
+
+/// @brief Global Surface Interpolation Of A Grid, points(i, j) Along u With i. A9.4 In The NURBS Book.
+/// Both Collocation Matrices Are Factored Once And Shared By All Rows And Columns.
+inline tinynurbs::RationalSurface<float> InterpolateSurface(const tinynurbs::array2<glm::vec3>& points, const size_t degree_u, const size_t degree_v,
+                                                            const Parametrization parametrization = Parametrization::ChordLength, const size_t num_threads = 0)
+{
+    assert(points.rows() > degree_u && points.cols() > degree_v);
+
+    const auto u_parameters = FittingParameters(points, true, parametrization);
+    const auto v_parameters = FittingParameters(points, false, parametrization);
+
+    tinynurbs::RationalSurface<float> srf;
+    srf.degree_u = degree_u;
+    srf.degree_v = degree_v;
+    srf.knots_u = InterpolationKnots(degree_u, u_parameters);
+    srf.knots_v = InterpolationKnots(degree_v, v_parameters);
+
+    const internal::Interpolator fit_u(degree_u, srf.knots_u, u_parameters);
+    const internal::Interpolator fit_v(degree_v, srf.knots_v, v_parameters);
+
+    srf.control_points = internal::FitGrid(points, fit_u, points.rows(), fit_v, points.cols(), num_threads);
+    srf.weights = tinynurbs::array2<float>(points.rows(), points.cols(), 1.0f);
+    return srf;
+}
+
+/// @brief Least Squares Surface Approximation Of A Grid With num_u x num_v Control Points, By Approximating Columns
+/// Then Rows (Section 9.4.3 In The NURBS Book). Corners Are Interpolated.
+inline tinynurbs::RationalSurface<float> ApproximateSurface(const tinynurbs::array2<glm::vec3>& points, const size_t degree_u, const size_t degree_v,
+                                                            const size_t num_u, const size_t num_v,
+                                                            const Parametrization parametrization = Parametrization::ChordLength, const size_t num_threads = 0)
+{
+    assert(num_u > degree_u && num_u <= points.rows() && num_v > degree_v && num_v <= points.cols());
+
+    const auto u_parameters = FittingParameters(points, true, parametrization);
+    const auto v_parameters = FittingParameters(points, false, parametrization);
+
+    tinynurbs::RationalSurface<float> srf;
+    srf.degree_u = degree_u;
+    srf.degree_v = degree_v;
+    srf.knots_u = ApproximationKnots(degree_u, u_parameters, num_u);
+    srf.knots_v = ApproximationKnots(degree_v, v_parameters, num_v);
+
+    const internal::Approximator fit_u(degree_u, srf.knots_u, u_parameters, num_u);
+    const internal::Approximator fit_v(degree_v, srf.knots_v, v_parameters, num_v);
+
+    srf.control_points = internal::FitGrid(points, fit_u, num_u, fit_v, num_v, num_threads);
+    srf.weights = tinynurbs::array2<float>(num_u, num_v, 1.0f);
+    return srf;
+}
+
+}
+
+#endif //FITTING_H
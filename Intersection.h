@@ -0,0 +1,607 @@
+/**
+  ******************************************************************************
+  * @file           : Intersection.h
+  * @author         : AliceRemake
+  * @brief          : Surface Surface Intersection
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef INTERSECTION_H
+#define INTERSECTION_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Bezier.h>
+#include <Parallel.h>
+#include <Tessellation.h>
+
+namespace NURBS
+{
+
+/// @brief A Point On Both Surfaces: point ~ SurfacePoint(srf0, uv0) ~ SurfacePoint(srf1, uv1).
+struct IntersectionPoint
+{
+    glm::vec3 point;
+    glm::vec2 uv0;
+    glm::vec2 uv1;
+};
+
+/// @brief Polyline Along One Intersection Branch. Closed Loops Repeat The First Point At The End.
+using IntersectionCurve = std::vector<IntersectionPoint>;
+
+struct IntersectionOptions
+{
+    /// @brief Max Distance Between The Two Surface Points Of An Accepted Intersection Point.
+    float tolerance = 1e-5f;
+    /// @brief Marching Step Length In Model Space.
+    float step = 1e-2f;
+    /// @brief Patch Bounding Box Diagonal Below Which Subdivision Stops And A Seed Is Refined. 0 Means step.
+    float seed_size = 0.0f;
+    size_t max_depth = 24;
+    size_t max_points = 100000;
+    /// @brief Threads For The Patch Pair Search. 0 Means All Cores.
+    size_t num_threads = 0;
+};
+
+namespace internal
+{
+
+/// @brief Solve a x = b By Gaussian Elimination With Partial Pivoting. False If a Is Singular.
+template <size_t N>
+bool SolveLinear(std::array<std::array<double, N>, N> a, std::array<double, N> b, std::array<double, N>& x)
+{
+    for (size_t c = 0; c < N; ++c)
+    {
+        size_t pivot = c;
+        for (size_t r = c + 1; r < N; ++r)
+        {
+            if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+            {
+                pivot = r;
+            }
+        }
+        if (std::abs(a[pivot][c]) < 1e-14)
+        {
+            return false;
+        }
+        std::swap(a[c], a[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (size_t r = c + 1; r < N; ++r)
+        {
+            const double f = a[r][c] / a[c][c];
+            for (size_t k = c; k < N; ++k)
+            {
+                a[r][k] -= f * a[c][k];
+            }
+            b[r] -= f * b[c];
+        }
+    }
+    for (size_t c = N; c-- > 0;)
+    {
+        double sum = b[c];
+        for (size_t k = c + 1; k < N; ++k)
+        {
+            sum -= a[c][k] * x[k];
+        }
+        x[c] = sum / a[c][c];
+    }
+    return true;
+}
+
+/// @brief A Bezier Patch Of A Surface Over [uv_min, uv_max] With The Box Of Its Projected Control Points, Which
+/// Contains The Patch When Weights Are Positive.
+struct BezierPatch
+{
+    size_t degree_u = 0;
+    size_t degree_v = 0;
+    glm::vec2 uv_min;
+    glm::vec2 uv_max;
+    std::vector<glm::vec4> control_points;
+    BoundingBox bounding_box;
+
+    void UpdateBounds()
+    {
+        bounding_box = BoundingBox();
+        for (const glm::vec4& control_point : control_points)
+        {
+            bounding_box.Expand(glm::vec3(control_point) / control_point.w);
+        }
+    }
+
+    [[nodiscard]] float Size() const
+    {
+        return glm::distance(bounding_box.min, bounding_box.max);
+    }
+
+    /// @brief Four Children, Split At The Parameter Midpoints.
+    [[nodiscard]] std::array<BezierPatch, 4> Split() const
+    {
+        const size_t stride = degree_v + 1;
+        const glm::vec2 uv_mid = 0.5f * (uv_min + uv_max);
+
+        std::array<BezierPatch, 4> children;
+        children.fill(*this);
+
+        // Along u: children[0] <- Low u, children[2] <- High u.
+        for (size_t l = 0; l <= degree_v; ++l)
+        {
+            SplitBezier(children[0].control_points.data() + l, children[2].control_points.data() + l, degree_u, stride);
+        }
+        // Along v: children[0|2] <- Low v, children[1|3] <- High v.
+        for (const size_t c : { 0, 2 })
+        {
+            children[c+1].control_points = children[c].control_points;
+            for (size_t k = 0; k <= degree_u; ++k)
+            {
+                SplitBezier(children[c].control_points.data() + k * stride, children[c+1].control_points.data() + k * stride, degree_v, 1);
+            }
+        }
+
+        children[0].uv_max = uv_mid;
+        children[1].uv_min = glm::vec2(uv_min.x, uv_mid.y);
+        children[1].uv_max = glm::vec2(uv_mid.x, uv_max.y);
+        children[2].uv_min = glm::vec2(uv_mid.x, uv_min.y);
+        children[2].uv_max = glm::vec2(uv_max.x, uv_mid.y);
+        children[3].uv_min = uv_mid;
+
+        for (BezierPatch& child : children)
+        {
+            child.UpdateBounds();
+        }
+        return children;
+    }
+};
+
+inline std::vector<BezierPatch> BezierPatches(const tinynurbs::RationalSurface<float>& srf)
+{
+    const auto u_spans = KnotSpans(srf.degree_u, srf.knots_u);
+    const auto v_spans = KnotSpans(srf.degree_v, srf.knots_v);
+    auto decomposition = DecomposeBezier<float>(srf);
+
+    std::vector<BezierPatch> patches(decomposition.size());
+    for (size_t s = 0; s < u_spans.size(); ++s)
+    {
+        for (size_t r = 0; r < v_spans.size(); ++r)
+        {
+            BezierPatch& patch = patches[s * v_spans.size() + r];
+            patch.degree_u = srf.degree_u;
+            patch.degree_v = srf.degree_v;
+            patch.uv_min = glm::vec2(srf.knots_u[u_spans[s]], srf.knots_v[v_spans[r]]);
+            patch.uv_max = glm::vec2(srf.knots_u[u_spans[s]+1], srf.knots_v[v_spans[r]+1]);
+            patch.control_points = std::move(decomposition[s * v_spans.size() + r]);
+            patch.UpdateBounds();
+        }
+    }
+    return patches;
+}
+
+[[nodiscard]] inline bool Overlap(const BoundingBox& a, const BoundingBox& b, const float margin) noexcept
+{
+    return a.min.x <= b.max.x + margin && b.min.x <= a.max.x + margin &&
+           a.min.y <= b.max.y + margin && b.min.y <= a.max.y + margin &&
+           a.min.z <= b.max.z + margin && b.min.z <= a.max.z + margin;
+}
+
+/// @brief Evaluates Both Surfaces And Their First Partials At x = (u0, v0, u1, v1).
+class IntersectionEvaluator
+{
+public:
+    IntersectionEvaluator(const tinynurbs::RationalSurface<float>& srf0, const tinynurbs::RationalSurface<float>& srf1)
+        : srf_{ &srf0, &srf1 }
+    {
+        for (size_t i = 0; i < 2; ++i)
+        {
+            domain_min_[i] = glm::dvec2(srf_[i]->knots_u[srf_[i]->degree_u], srf_[i]->knots_v[srf_[i]->degree_v]);
+            domain_max_[i] = glm::dvec2(srf_[i]->knots_u[srf_[i]->control_points.rows()], srf_[i]->knots_v[srf_[i]->control_points.cols()]);
+        }
+    }
+
+    /// @brief S[i], Su[i], Sv[i] Of Surface i.
+    void Evaluate(const std::array<double, 4>& x)
+    {
+        for (size_t i = 0; i < 2; ++i)
+        {
+            std::array<glm::vec3, 4> ders;
+            SurfaceDerivatives(context_, *srf_[i], 1, (float)x[2*i], (float)x[2*i+1], ders);
+            S[i] = glm::dvec3(ders[0]);
+            Sv[i] = glm::dvec3(ders[1]);
+            Su[i] = glm::dvec3(ders[2]);
+        }
+    }
+
+    /// @brief Clamp x Into Both Domains. True If Any Parameter Was On Or Beyond A Boundary.
+    bool Clamp(std::array<double, 4>& x) const
+    {
+        bool clamped = false;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const double lo = domain_min_[i/2][i%2], hi = domain_max_[i/2][i%2];
+            if (x[i] <= lo || x[i] >= hi)
+            {
+                clamped = true;
+                x[i] = std::clamp(x[i], lo, hi);
+            }
+        }
+        return clamped;
+    }
+
+    /// @brief Largest alpha In [0, 1] Keeping x + alpha * dx Inside Both Domains.
+    [[nodiscard]] double MaxStep(const std::array<double, 4>& x, const std::array<double, 4>& dx) const
+    {
+        double alpha = 1.0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const double lo = domain_min_[i/2][i%2], hi = domain_max_[i/2][i%2];
+            if (x[i] + dx[i] > hi)
+            {
+                alpha = std::min(alpha, (hi - x[i]) / dx[i]);
+            }
+            else if (x[i] + dx[i] < lo)
+            {
+                alpha = std::min(alpha, (lo - x[i]) / dx[i]);
+            }
+        }
+        return std::max(alpha, 0.0);
+    }
+
+    [[nodiscard]] double Bound(const size_t i, const double value) const
+    {
+        const double lo = domain_min_[i/2][i%2], hi = domain_max_[i/2][i%2];
+        return std::abs(value - lo) < std::abs(value - hi) ? lo : hi;
+    }
+
+    std::array<glm::dvec3, 2> S, Su, Sv;
+
+private:
+    std::array<const tinynurbs::RationalSurface<float>*, 2> srf_;
+    std::array<glm::dvec2, 2> domain_min_, domain_max_;
+    EvaluationContext context_;
+};
+
+/// @brief Newton Iteration Onto The Intersection. With fixed < 4 Parameter x[fixed] Is Held, Otherwise The Point Is
+/// Kept On The Plane Through center With Normal tangent, Or, Without A tangent, The Minimum Norm Step Is Taken.
+inline bool Correct(IntersectionEvaluator& evaluator, std::array<double, 4>& x, const double tolerance,
+                    const glm::dvec3* tangent = nullptr, const glm::dvec3& center = glm::dvec3(0.0), const size_t fixed = 4)
+{
+    for (size_t iteration = 0; iteration < 16; ++iteration)
+    {
+        evaluator.Evaluate(x);
+        const glm::dvec3 F = evaluator.S[0] - evaluator.S[1];
+        const std::array<glm::dvec3, 4> J = { evaluator.Su[0], evaluator.Sv[0], -evaluator.Su[1], -evaluator.Sv[1] };
+
+        const double plane = tangent ? glm::dot(*tangent, evaluator.S[0] - center) : 0.0;
+        if (glm::length(F) < tolerance && std::abs(plane) < tolerance)
+        {
+            return true;
+        }
+
+        std::array<double, 4> dx{};
+
+        if (fixed < 4 || tangent)
+        {
+            std::array<std::array<double, 4>, 4> a{};
+            std::array<double, 4> b{};
+            for (size_t r = 0; r < 3; ++r)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    a[r][c] = J[c][r];
+                }
+                b[r] = -F[r];
+            }
+            if (fixed < 4)
+            {
+                a[3][fixed] = 1.0;
+            }
+            else
+            {
+                a[3] = { glm::dot(*tangent, J[0]), glm::dot(*tangent, J[1]), 0.0, 0.0 };
+                b[3] = -plane;
+            }
+            if (!SolveLinear(a, b, dx))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // dx = J^T (J J^T)^-1 (-F).
+            std::array<std::array<double, 3>, 3> a{};
+            for (size_t r = 0; r < 3; ++r)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    for (size_t k = 0; k < 4; ++k)
+                    {
+                        a[r][c] += J[k][r] * J[k][c];
+                    }
+                }
+            }
+            std::array<double, 3> y{};
+            if (!SolveLinear(a, { -F.x, -F.y, -F.z }, y))
+            {
+                return false;
+            }
+            for (size_t k = 0; k < 4; ++k)
+            {
+                dx[k] = glm::dot(J[k], glm::dvec3(y[0], y[1], y[2]));
+            }
+        }
+
+        for (size_t k = 0; k < 4; ++k)
+        {
+            x[k] += dx[k];
+        }
+        evaluator.Clamp(x);
+    }
+    evaluator.Evaluate(x);
+    return glm::distance(evaluator.S[0], evaluator.S[1]) < tolerance;
+}
+
+/// @brief Parameter Increment Moving Surface i By delta To First Order (Least Squares On [Su Sv]).
+inline glm::dvec2 ParameterStep(const glm::dvec3& Su, const glm::dvec3& Sv, const glm::dvec3& delta)
+{
+    std::array<double, 2> d{};
+    if (!SolveLinear<2>({{ { glm::dot(Su, Su), glm::dot(Su, Sv) }, { glm::dot(Sv, Su), glm::dot(Sv, Sv) } }},
+                        { glm::dot(Su, delta), glm::dot(Sv, delta) }, d))
+    {
+        return glm::dvec2(0.0);
+    }
+    return glm::dvec2(d[0], d[1]);
+}
+
+/// @brief Intersection Direction n0 x n1, Zero Where The Surfaces Touch Tangentially.
+inline glm::dvec3 Tangent(const IntersectionEvaluator& evaluator)
+{
+    const glm::dvec3 t = glm::cross(glm::cross(evaluator.Su[0], evaluator.Sv[0]), glm::cross(evaluator.Su[1], evaluator.Sv[1]));
+    const double length = glm::length(t);
+    return length < 1e-12 ? glm::dvec3(0.0) : t / length;
+}
+
+inline IntersectionPoint ToIntersectionPoint(const IntersectionEvaluator& evaluator, const std::array<double, 4>& x)
+{
+    return { glm::vec3(0.5 * (evaluator.S[0] + evaluator.S[1])), glm::vec2((float)x[0], (float)x[1]), glm::vec2((float)x[2], (float)x[3]) };
+}
+
+/// @brief March From seed Along direction * (n0 x n1) Until A Boundary, The Start Again (closed) Or A Singularity.
+inline std::vector<std::array<double, 4>> March(IntersectionEvaluator& evaluator, const std::array<double, 4>& seed, const double direction,
+                                                const IntersectionOptions& options, bool& closed)
+{
+    closed = false;
+
+    std::vector<std::array<double, 4>> path = { seed };
+    std::array<double, 4> x = seed;
+    evaluator.Evaluate(x);
+    const glm::dvec3 start = evaluator.S[0];
+    glm::dvec3 previous_tangent = direction * Tangent(evaluator);
+    glm::dvec3 previous_point = start;
+
+    double h = options.step;
+    double length = 0.0;
+
+    while (path.size() < options.max_points && h > options.step * 1e-3)
+    {
+        evaluator.Evaluate(x);
+        glm::dvec3 tangent = Tangent(evaluator);
+        if (tangent == glm::dvec3(0.0))
+        {
+            break;
+        }
+        if (glm::dot(tangent, previous_tangent) < 0.0)
+        {
+            tangent = -tangent;
+        }
+
+        // Predictor: A Step Of Length h Along The Tangent, Shortened To Stay In Both Domains.
+        const glm::dvec2 d0 = ParameterStep(evaluator.Su[0], evaluator.Sv[0], h * tangent);
+        const glm::dvec2 d1 = ParameterStep(evaluator.Su[1], evaluator.Sv[1], h * tangent);
+        const std::array<double, 4> dx = { d0.x, d0.y, d1.x, d1.y };
+        const double alpha = evaluator.MaxStep(x, dx);
+        const bool boundary = alpha < 1.0;
+        if (alpha * h < options.tolerance)
+        {
+            break;
+        }
+
+        std::array<double, 4> next;
+        for (size_t k = 0; k < 4; ++k)
+        {
+            next[k] = x[k] + alpha * dx[k];
+        }
+        const glm::dvec3 center = evaluator.S[0] + alpha * h * tangent;
+
+        // Corrector: Back Onto Both Surfaces, On The Boundary Or On The Plane Normal To The Tangent.
+        bool converged;
+        if (boundary)
+        {
+            size_t fixed = 0;
+            for (size_t k = 0; k < 4; ++k)
+            {
+                if (std::abs(next[k] - evaluator.Bound(k, next[k])) < std::abs(next[fixed] - evaluator.Bound(fixed, next[fixed])))
+                {
+                    fixed = k;
+                }
+            }
+            next[fixed] = evaluator.Bound(fixed, next[fixed]);
+            converged = Correct(evaluator, next, options.tolerance, nullptr, center, fixed);
+        }
+        else
+        {
+            converged = Correct(evaluator, next, options.tolerance, &tangent, center);
+        }
+
+        // Retry With A Shorter Step On Failure Or A Sharp Turn.
+        const glm::dvec3 point = evaluator.S[0];
+        const glm::dvec3 next_tangent = Tangent(evaluator);
+        if (!converged || std::abs(glm::dot(next_tangent, tangent)) < 0.9 || glm::distance(point, center) > h)
+        {
+            h *= 0.5;
+            continue;
+        }
+
+        length += glm::distance(point, previous_point);
+
+        if (path.size() > 2 && length > 3.0 * h && glm::distance(point, start) < h)
+        {
+            path.push_back(seed);
+            closed = true;
+            break;
+        }
+
+        path.push_back(next);
+        x = next;
+        previous_tangent = tangent;
+        previous_point = point;
+
+        if (boundary || evaluator.Clamp(next))
+        {
+            break;
+        }
+
+        h = std::min<double>(options.step, 1.5 * h);
+    }
+
+    return path;
+}
+
+/// @brief Subdivide The Larger Patch While The Boxes Overlap. Converged Leaves Give Seeds Of Intersection Branches.
+inline void CollectSeeds(IntersectionEvaluator& evaluator, const BezierPatch& a, const BezierPatch& b, const size_t depth,
+                         const IntersectionOptions& options, const float seed_size, std::vector<std::array<double, 4>>& seeds)
+{
+    if (!Overlap(a.bounding_box, b.bounding_box, options.tolerance))
+    {
+        return;
+    }
+
+    const float size_a = a.Size(), size_b = b.Size();
+
+    if ((size_a <= seed_size && size_b <= seed_size) || depth >= options.max_depth)
+    {
+        const glm::vec2 uv0 = 0.5f * (a.uv_min + a.uv_max);
+        const glm::vec2 uv1 = 0.5f * (b.uv_min + b.uv_max);
+        std::array<double, 4> x = { uv0.x, uv0.y, uv1.x, uv1.y };
+        if (Correct(evaluator, x, options.tolerance))
+        {
+            seeds.push_back(x);
+        }
+        return;
+    }
+
+    if (size_a >= size_b)
+    {
+        for (const BezierPatch& child : a.Split())
+        {
+            CollectSeeds(evaluator, child, b, depth + 1, options, seed_size, seeds);
+        }
+    }
+    else
+    {
+        for (const BezierPatch& child : b.Split())
+        {
+            CollectSeeds(evaluator, a, child, depth + 1, options, seed_size, seeds);
+        }
+    }
+}
+
+/// @brief Distance From p To The Polyline.
+inline float DistanceToPolyline(const IntersectionCurve& curve, const glm::vec3& p)
+{
+    float distance = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < curve.size(); ++i)
+    {
+        if (i + 1 == curve.size())
+        {
+            distance = std::min(distance, glm::distance(p, curve[i].point));
+            break;
+        }
+        const glm::vec3 a = curve[i].point, ab = curve[i+1].point - a;
+        const float t = glm::dot(ab, ab) > 0.0f ? std::clamp(glm::dot(p - a, ab) / glm::dot(ab, ab), 0.0f, 1.0f) : 0.0f;
+        distance = std::min(distance, glm::distance(p, a + t * ab));
+    }
+    return distance;
+}
+
+}
+
+/// @brief Intersection Curves Of Two Surfaces With Clamped Knots And Positive Weights.
+///
+/// 1. Both Surfaces Are Split Into Bezier Patches, And Every Pair Of Patches With Overlapping Control Point Boxes Is
+///    Recursively Subdivided (Larger Patch First) While The Boxes Overlap. Pairs Run In Parallel.
+/// 2. Leaves Smaller Than seed_size Are Refined Onto The Intersection By Newton's Method, Giving Seeds.
+/// 3. From Each Seed Not On An Already Traced Branch, The Branch Is Traced In Both Directions: Step h Along
+///    n0 x n1 (Predictor, Mapped To (u, v) Through SurfaceDerivatives), Then Newton Back Onto Both Surfaces Within The
+///    Plane Normal To The Step (Corrector), Halving h On Failure, Until A Domain Boundary Or The Seed Is Reached.
+///
+/// Tangential Contact, Where n0 x n1 Vanishes, Ends A Branch.
+///
+inline std::vector<IntersectionCurve> IntersectSurfaces(const tinynurbs::RationalSurface<float>& srf0, const tinynurbs::RationalSurface<float>& srf1,
+                                                        const IntersectionOptions& options = {})
+{
+    const float seed_size = options.seed_size > 0.0f ? options.seed_size : options.step;
+    const auto patches0 = internal::BezierPatches(srf0);
+    const auto patches1 = internal::BezierPatches(srf1);
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t i = 0; i < patches0.size(); ++i)
+    {
+        for (size_t j = 0; j < patches1.size(); ++j)
+        {
+            if (internal::Overlap(patches0[i].bounding_box, patches1[j].bounding_box, options.tolerance))
+            {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::array<double, 4>>> pair_seeds(pairs.size());
+    ParallelFor(0, pairs.size(), [&](const size_t p)
+    {
+        internal::IntersectionEvaluator evaluator(srf0, srf1);
+        internal::CollectSeeds(evaluator, patches0[pairs[p].first], patches1[pairs[p].second], 0, options, seed_size, pair_seeds[p]);
+    }, options.num_threads);
+
+    std::vector<IntersectionCurve> curves;
+    internal::IntersectionEvaluator evaluator(srf0, srf1);
+
+    for (const auto& seeds : pair_seeds)
+    {
+        for (const auto& seed : seeds)
+        {
+            evaluator.Evaluate(seed);
+            const glm::vec3 point(0.5 * (evaluator.S[0] + evaluator.S[1]));
+            if (std::any_of(curves.begin(), curves.end(), [&](const IntersectionCurve& curve) { return internal::DistanceToPolyline(curve, point) < 0.5f * options.step; }))
+            {
+                continue;
+            }
+
+            bool closed = false;
+            const auto forward = internal::March(evaluator, seed, 1.0, options, closed);
+            std::vector<std::array<double, 4>> path;
+            if (!closed)
+            {
+                bool unused = false;
+                const auto backward = internal::March(evaluator, seed, -1.0, options, unused);
+                path.assign(backward.rbegin(), backward.rend() - 1);
+            }
+            path.insert(path.end(), forward.begin(), forward.end());
+
+            IntersectionCurve& curve = curves.emplace_back();
+            for (const auto& x : path)
+            {
+                evaluator.Evaluate(x);
+                curve.push_back(internal::ToIntersectionPoint(evaluator, x));
+            }
+        }
+    }
+
+    return curves;
+}
+
+}
+
+#endif //INTERSECTION_H
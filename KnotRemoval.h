@@ -0,0 +1,495 @@
+/**
+  ******************************************************************************
+  * @file           : KnotRemoval.h
+  * @author         : AliceRemake
+  * @brief          : Tolerance Bounded Knot Removal And Model Simplification
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef KNOT_REMOVAL_H
+#define KNOT_REMOVAL_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Degree.h>
+#include <Parallel.h>
+
+namespace NURBS
+{
+
+/// @brief Remove u = knots[r] Up To num Times, Stopping At The First Removal Moving The Curve More Than tolerance.
+/// A5.8 In The NURBS Book.
+///
+/// r Is The Last Index Of u And s Its Multiplicity. knots And control_points Shrink By The Number Of Removals.
+/// Point Is Any Type Supporting Point * float And Point + Point, e.g. Homogeneous Control Points.
+///
+/// @param error Increased By The Deviation Bound Of Every Removal Done.
+/// @return Number Of Removals.
+template <typename Point>
+size_t RemoveKnot(const size_t degree, std::vector<float>& knots, std::vector<Point>& control_points, const size_t r, const size_t s,
+                  const size_t num, const float tolerance, float* error = nullptr)
+{
+    using Index = long long;
+
+    assert(knots.size() == control_points.size() + degree + 1);
+    assert(r > degree && r + degree + 1 < knots.size() && s >= 1 && s <= degree);
+
+    const Index p = (Index)degree;
+    const Index n = (Index)control_points.size() - 1;
+    const Index m = n + p + 1;
+    const Index ord = p + 1;
+    const Index fout = (2 * (Index)r - (Index)s - p) / 2;
+    const float u = knots[r];
+
+    const auto U = [&](const Index i) { return knots[i]; };
+    const auto Pw = [&](const Index i) -> Point& { return control_points[i]; };
+
+    Index first = (Index)r - p, last = (Index)r - (Index)s;
+    std::vector<Point> temp(2 * p + 1);
+
+    Index t = 0;
+    for (; t < (Index)num; ++t)
+    {
+        // Compute New Control Points From Both Ends Towards The Middle.
+        const Index off = first - 1;
+        temp[0] = Pw(off);
+        temp[last+1-off] = Pw(last+1);
+        Index i = first, j = last, ii = 1, jj = last - off;
+        while (j - i > t)
+        {
+            const float alfi = (u - U(i)) / (U(i+ord+t) - U(i));
+            const float alfj = (u - U(j-t)) / (U(j+ord) - U(j-t));
+            temp[ii] = (Pw(i) - temp[ii-1] * (1.0f - alfi)) / alfi;
+            temp[jj] = (Pw(j) - temp[jj+1] * alfj) / (1.0f - alfj);
+            ++i;
+            ++ii;
+            --j;
+            --jj;
+        }
+
+        // Removable If Both Ends Meet.
+        float distance;
+        if (j - i < t)
+        {
+            distance = glm::distance(temp[ii-1], temp[jj+1]);
+        }
+        else
+        {
+            const float alfi = (u - U(i)) / (U(i+ord+t) - U(i));
+            distance = glm::distance(Pw(i), temp[ii+t+1] * alfi + temp[ii-1] * (1.0f - alfi));
+        }
+        if (distance > tolerance)
+        {
+            break;
+        }
+        if (error)
+        {
+            *error += distance;
+        }
+
+        i = first;
+        j = last;
+        while (j - i > t)
+        {
+            Pw(i) = temp[i-off];
+            Pw(j) = temp[j-off];
+            ++i;
+            --j;
+        }
+        --first;
+        ++last;
+    }
+
+    if (t == 0)
+    {
+        return 0;
+    }
+
+    for (Index k = (Index)r + 1; k <= m; ++k)
+    {
+        knots[k-t] = knots[k];
+    }
+    knots.resize(knots.size() - t);
+
+    Index j = fout, i = j;
+    for (Index k = 1; k < t; ++k)
+    {
+        if (k % 2 == 1)
+        {
+            ++i;
+        }
+        else
+        {
+            --j;
+        }
+    }
+    for (Index k = i + 1; k <= n; ++k)
+    {
+        Pw(j++) = Pw(k);
+    }
+    control_points.resize(control_points.size() - t);
+
+    return (size_t)t;
+}
+
+namespace internal
+{
+
+/// @brief Last Index And Multiplicity Of An Interior Knot u, Or Nothing If u Is Not One.
+inline std::optional<std::pair<size_t, size_t>> InteriorKnot(const size_t degree, const std::vector<float>& knots, const float u)
+{
+    const auto upper = std::upper_bound(knots.begin() + (long long)degree + 1, knots.end() - (long long)degree - 1, u);
+    const auto lower = std::lower_bound(knots.begin() + (long long)degree + 1, upper, u);
+    if (lower == upper)
+    {
+        return std::nullopt;
+    }
+    return std::pair{ (size_t)(upper - knots.begin()) - 1, (size_t)(upper - lower) };
+}
+
+/// @brief Parameter Range Moved By Removing knots[r] num Times: The Support Of Control Points [r - p - num + 1, r - s + num - 1].
+inline std::pair<float, float> RemovalRange(const size_t degree, const std::vector<float>& knots, const size_t r, const size_t s, const size_t num)
+{
+    const size_t n = knots.size() - degree - 2;
+    const size_t first = r + 1 >= degree + num ? r + 1 - degree - num : 0;
+    const size_t last = std::min(n, r - s + num - 1);
+    return { knots[first], knots[last+degree+1] };
+}
+
+/// @brief Deviation Spent So Far On Each Span Of The Original Knot Vector. Removals Only Delete Knots, So The
+/// Original Spans Stay Valid, And The Deviations Of Removals Overlapping A Span Add Up.
+struct ErrorBudget
+{
+    ErrorBudget(const size_t degree, const std::vector<float>& knots)
+        : breakpoints(Breakpoints(degree, knots)), errors(breakpoints.size() - 1, 0.0f)
+    {}
+
+    [[nodiscard]] float Max(const std::pair<float, float>& range) const
+    {
+        float error = 0.0f;
+        for (size_t k = 0; k < errors.size(); ++k)
+        {
+            if (breakpoints[k] < range.second && breakpoints[k+1] > range.first)
+            {
+                error = std::max(error, errors[k]);
+            }
+        }
+        return error;
+    }
+
+    void Add(const std::pair<float, float>& range, const float error)
+    {
+        for (size_t k = 0; k < errors.size(); ++k)
+        {
+            if (breakpoints[k] < range.second && breakpoints[k+1] > range.first)
+            {
+                errors[k] += error;
+            }
+        }
+    }
+
+    [[nodiscard]] float Max() const
+    {
+        return errors.empty() ? 0.0f : *std::ranges::max_element(errors);
+    }
+
+    std::vector<float> breakpoints;
+    std::vector<float> errors;
+};
+
+inline std::vector<glm::vec4> Homogeneous(const tinynurbs::RationalCurve<float>& crv)
+{
+    std::vector<glm::vec4> homo_control_points(crv.control_points.size());
+    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    {
+        homo_control_points[i] = Homogeneous(crv.control_points[i], crv.weights[i]);
+    }
+    return homo_control_points;
+}
+
+/// @brief Columns (along_u) Or Rows Of A Homogeneous Control Net As Separate Curves.
+inline std::vector<std::vector<glm::vec4>> Lines(const tinynurbs::array2<glm::vec4>& points, const bool along_u)
+{
+    std::vector<std::vector<glm::vec4>> lines(along_u ? points.cols() : points.rows());
+    for (size_t i = 0; i < points.rows(); ++i)
+    {
+        for (size_t j = 0; j < points.cols(); ++j)
+        {
+            lines[along_u ? j : i].push_back(points(i, j));
+        }
+    }
+    return lines;
+}
+
+inline tinynurbs::array2<glm::vec4> FromLines(const std::vector<std::vector<glm::vec4>>& lines, const bool along_u)
+{
+    const size_t size = lines.front().size();
+    tinynurbs::array2<glm::vec4> points(along_u ? size : lines.size(), along_u ? lines.size() : size);
+    for (size_t l = 0; l < lines.size(); ++l)
+    {
+        for (size_t k = 0; k < size; ++k)
+        {
+            (along_u ? points(k, l) : points(l, k)) = lines[l][k];
+        }
+    }
+    return points;
+}
+
+/// @brief Remove knots[r] Up To num Times From Every Line Together, Each Removal Only If All Lines Stay Within tolerance.
+inline size_t RemoveKnot(const size_t degree, std::vector<float>& knots, std::vector<std::vector<glm::vec4>>& lines,
+                         const size_t r, const size_t s, const size_t num, const float tolerance, float* error = nullptr)
+{
+    size_t t = 0;
+    for (; t < num; ++t)
+    {
+        std::vector<float> removed_knots;
+        std::vector<std::vector<glm::vec4>> removed_lines = lines;
+        float max_error = 0.0f;
+
+        bool removable = true;
+        for (auto& line : removed_lines)
+        {
+            removed_knots = knots;
+            float line_error = 0.0f;
+            if (NURBS::RemoveKnot(degree, removed_knots, line, r - t, s - t, 1, tolerance, &line_error) == 0)
+            {
+                removable = false;
+                break;
+            }
+            max_error = std::max(max_error, line_error);
+        }
+        if (!removable)
+        {
+            break;
+        }
+
+        knots = std::move(removed_knots);
+        lines = std::move(removed_lines);
+        if (error)
+        {
+            *error += max_error;
+        }
+    }
+    return t;
+}
+
+}
+
+/// @brief Remove The Interior Knot u From crv Up To num Times, Each Removal Moving It At Most tolerance.
+/// @return Number Of Removals.
+inline size_t RemoveKnot(tinynurbs::RationalCurve<float>& crv, const float u, const size_t num, const float tolerance)
+{
+    const auto knot = internal::InteriorKnot(crv.degree, crv.knots, u);
+    if (!knot)
+    {
+        return 0;
+    }
+
+    auto homo_control_points = internal::Homogeneous(crv);
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, crv.weights, crv.control_points);
+    const size_t removed = RemoveKnot(crv.degree, crv.knots, homo_control_points, knot->first, knot->second, num, homo_tolerance);
+
+    crv = internal::FromHomogeneous(crv.degree, std::move(crv.knots), homo_control_points);
+    return removed;
+}
+
+/// @brief Remove The Interior Knot u In u (along_u) Or v From srf Up To num Times, Each Removal Moving It At Most tolerance.
+/// @return Number Of Removals.
+inline size_t RemoveKnot(tinynurbs::RationalSurface<float>& srf, const bool along_u, const float u, const size_t num, const float tolerance)
+{
+    const size_t degree = along_u ? srf.degree_u : srf.degree_v;
+    auto& knots = along_u ? srf.knots_u : srf.knots_v;
+    const auto knot = internal::InteriorKnot(degree, knots, u);
+    if (!knot)
+    {
+        return 0;
+    }
+
+    const auto weights = std::span<const float>(srf.weights.data(), srf.weights.rows() * srf.weights.cols());
+    const auto control_points = std::span<const glm::vec3>(srf.control_points.data(), srf.control_points.rows() * srf.control_points.cols());
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, weights, control_points);
+
+    auto lines = internal::Lines(internal::Homogeneous(srf), along_u);
+    const size_t removed = internal::RemoveKnot(degree, knots, lines, knot->first, knot->second, num, homo_tolerance);
+
+    internal::FromHomogeneous(internal::FromLines(lines, along_u), srf);
+    return removed;
+}
+
+struct SimplifyReport
+{
+    size_t control_points_before = 0;
+    size_t control_points_after = 0;
+    size_t knots_removed = 0;
+    /// @brief Largest Distance Between Original And Simplified Geometry, Measured At Samples.
+    float max_deviation = 0.0f;
+
+    SimplifyReport& operator+=(const SimplifyReport& other)
+    {
+        control_points_before += other.control_points_before;
+        control_points_after += other.control_points_after;
+        knots_removed += other.knots_removed;
+        max_deviation = std::max(max_deviation, other.max_deviation);
+        return *this;
+    }
+};
+
+/// @brief Remove Every Removable Interior Knot Of crv While Keeping It Within tolerance Of The Original.
+///
+/// Knots Are Visited Left To Right And Each Is Removed As Often As The Remaining Budget Of The Spans It Moves Allows,
+/// Charging The Budget After Every Single Removal, So The Accumulated Deviation Stays Bounded. The Deviation Is Then
+/// Measured With CurvePoint At num_samples Points Per Original Span.
+///
+inline SimplifyReport Simplify(tinynurbs::RationalCurve<float>& crv, const float tolerance, const size_t num_samples = 16)
+{
+    SimplifyReport report;
+    report.control_points_before = crv.control_points.size();
+
+    const tinynurbs::RationalCurve<float> original = crv;
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, crv.weights, crv.control_points);
+    auto homo_control_points = internal::Homogeneous(crv);
+    internal::ErrorBudget budget(crv.degree, crv.knots);
+
+    for (size_t r = crv.degree + 1; r + crv.degree + 1 < crv.knots.size();)
+    {
+        size_t s = 1;
+        while (r + crv.degree + 2 < crv.knots.size() && crv.knots[r+1] == crv.knots[r])
+        {
+            ++r;
+            ++s;
+        }
+
+        // One Removal At A Time, Each Only Allowed What The Previous Ones Left Of The Budget.
+        const auto range = internal::RemovalRange(crv.degree, crv.knots, r, s, s);
+        size_t removed = 0;
+        for (; removed < s; ++removed)
+        {
+            float error = 0.0f;
+            if (RemoveKnot(crv.degree, crv.knots, homo_control_points, r - removed, s - removed, 1, homo_tolerance - budget.Max(range), &error) == 0)
+            {
+                break;
+            }
+            budget.Add(range, error);
+        }
+        report.knots_removed += removed;
+        r = r + 1 - removed;
+    }
+
+    crv = internal::FromHomogeneous(crv.degree, std::move(crv.knots), homo_control_points);
+    report.control_points_after = crv.control_points.size();
+
+    EvaluationContext context;
+    for (size_t k = 0; k + 1 < budget.breakpoints.size(); ++k)
+    {
+        for (size_t j = 0; j <= num_samples; ++j)
+        {
+            const float u = std::lerp(budget.breakpoints[k], budget.breakpoints[k+1], (float)j / (float)num_samples);
+            report.max_deviation = std::max(report.max_deviation, glm::distance(CurvePoint(context, original, u), CurvePoint(context, crv, u)));
+        }
+    }
+
+    return report;
+}
+
+/// @brief Remove Every Removable Interior Knot Of srf In u Then v While Keeping It Within tolerance Of The Original.
+///
+/// As For Curves, With One Budget Per Direction: A Removal In One Direction May Use What The Other Has Left Over
+/// Everywhere. The Deviation Is Measured With SurfacePoint At num_samples x num_samples Points Per Original Patch.
+///
+inline SimplifyReport Simplify(tinynurbs::RationalSurface<float>& srf, const float tolerance, const size_t num_samples = 8)
+{
+    SimplifyReport report;
+    report.control_points_before = srf.control_points.rows() * srf.control_points.cols();
+
+    const tinynurbs::RationalSurface<float> original = srf;
+    const auto weights = std::span<const float>(srf.weights.data(), srf.weights.rows() * srf.weights.cols());
+    const auto control_points = std::span<const glm::vec3>(srf.control_points.data(), srf.control_points.rows() * srf.control_points.cols());
+    const float homo_tolerance = internal::HomogeneousTolerance(tolerance, weights, control_points);
+
+    std::array budgets = { internal::ErrorBudget(srf.degree_u, srf.knots_u), internal::ErrorBudget(srf.degree_v, srf.knots_v) };
+    auto homo_control_points = internal::Homogeneous(srf);
+
+    for (const bool along_u : { true, false })
+    {
+        const size_t degree = along_u ? srf.degree_u : srf.degree_v;
+        auto& knots = along_u ? srf.knots_u : srf.knots_v;
+        auto& budget = budgets[along_u ? 0 : 1];
+        const float other = budgets[along_u ? 1 : 0].Max();
+        auto lines = internal::Lines(homo_control_points, along_u);
+
+        for (size_t r = degree + 1; r + degree + 1 < knots.size();)
+        {
+            size_t s = 1;
+            while (r + degree + 2 < knots.size() && knots[r+1] == knots[r])
+            {
+                ++r;
+                ++s;
+            }
+
+            const auto range = internal::RemovalRange(degree, knots, r, s, s);
+            size_t removed = 0;
+            for (; removed < s; ++removed)
+            {
+                float error = 0.0f;
+                if (internal::RemoveKnot(degree, knots, lines, r - removed, s - removed, 1, homo_tolerance - other - budget.Max(range), &error) == 0)
+                {
+                    break;
+                }
+                budget.Add(range, error);
+            }
+            report.knots_removed += removed;
+            r = r + 1 - removed;
+        }
+
+        homo_control_points = internal::FromLines(lines, along_u);
+    }
+
+    internal::FromHomogeneous(homo_control_points, srf);
+    report.control_points_after = srf.control_points.rows() * srf.control_points.cols();
+
+    EvaluationContext context;
+    for (size_t k = 0; k + 1 < budgets[0].breakpoints.size(); ++k)
+    {
+        for (size_t l = 0; l + 1 < budgets[1].breakpoints.size(); ++l)
+        {
+            for (size_t a = 0; a <= num_samples; ++a)
+            {
+                for (size_t b = 0; b <= num_samples; ++b)
+                {
+                    const float u = std::lerp(budgets[0].breakpoints[k], budgets[0].breakpoints[k+1], (float)a / (float)num_samples);
+                    const float v = std::lerp(budgets[1].breakpoints[l], budgets[1].breakpoints[l+1], (float)b / (float)num_samples);
+                    report.max_deviation = std::max(report.max_deviation, glm::distance(SurfacePoint(context, original, u, v), SurfacePoint(context, srf, u, v)));
+                }
+            }
+        }
+    }
+
+    return report;
+}
+
+/// @brief Simplify A Whole Model, Entities In Parallel.
+inline SimplifyReport Simplify(const std::span<tinynurbs::RationalCurve<float>> curves, const std::span<tinynurbs::RationalSurface<float>> surfaces,
+                               const float tolerance, const size_t num_threads = 0)
+{
+    std::vector<SimplifyReport> reports(curves.size() + surfaces.size());
+    ParallelFor(0, reports.size(), [&](const size_t i)
+    {
+        reports[i] = i < curves.size() ? Simplify(curves[i], tolerance) : Simplify(surfaces[i - curves.size()], tolerance);
+    }, num_threads);
+
+    SimplifyReport report;
+    for (const auto& entity_report : reports)
+    {
+        report += entity_report;
+    }
+    return report;
+}
+
+}
+
+#endif //KNOT_REMOVAL_H
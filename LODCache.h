@@ -0,0 +1,369 @@
+/**
+  ******************************************************************************
+  * @file           : LODCache.h
+  * @author         : AliceRemake
+  * @brief          : Level Of Detail Tessellation Cache
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef LOD_CACHE_H
+#define LOD_CACHE_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Tessellation.h>
+
+namespace NURBS
+{
+
+/// @brief World Space Tolerance Whose Projection Is pixel_tolerance Pixels For A Pinhole Camera At eye With
+/// focal_length Measured In Pixels. The Distance Is Taken To The Nearest Point Of bounding_box (Conservative).
+inline float ScreenSpaceTolerance(const BoundingBox& bounding_box, const glm::vec3& eye, const float focal_length, const float pixel_tolerance)
+{
+    const glm::vec3 nearest = glm::clamp(eye, bounding_box.min, bounding_box.max);
+    const float distance = std::max(glm::distance(eye, nearest), std::numeric_limits<float>::epsilon());
+    return pixel_tolerance * distance / focal_length;
+}
+
+/// @brief One Level Of Detail: Every Knot Span Tile Tessellated At resolution = 2^level.
+///
+/// error Is The Measured Maximum Distance Between The Surface And The Bilinear Interpolation Of Each Grid Cell,
+/// Sampled At Cell Centers.
+///
+struct SurfaceLOD
+{
+    size_t level = 0;
+    size_t resolution = 0;
+    float error = 0.0f;
+    std::vector<SurfaceTile> tiles;
+
+    [[nodiscard]] size_t Bytes() const noexcept
+    {
+        size_t bytes = sizeof(SurfaceLOD);
+        for (const SurfaceTile& tile : tiles)
+        {
+            bytes += sizeof(SurfaceTile) + (tile.points.capacity() + tile.normals.capacity()) * sizeof(glm::vec3);
+        }
+        return bytes;
+    }
+};
+
+inline SurfaceLOD TessellateLOD(const tinynurbs::RationalSurface<float>& srf, const size_t level)
+{
+    SurfaceLOD lod;
+    lod.level = level;
+    lod.resolution = (size_t)1 << level;
+
+    EvaluationContext context;
+
+    for (const size_t u_span : KnotSpans(srf.degree_u, srf.knots_u))
+    {
+        for (const size_t v_span : KnotSpans(srf.degree_v, srf.knots_v))
+        {
+            SurfaceTile& tile = lod.tiles.emplace_back();
+            tile.u_span = u_span;
+            tile.v_span = v_span;
+            tile.resolution = lod.resolution;
+            TessellateTile(srf, tile);
+
+            const size_t samples = tile.resolution + 1;
+            const float du = (srf.knots_u[u_span+1] - srf.knots_u[u_span]) / (float)tile.resolution;
+            const float dv = (srf.knots_v[v_span+1] - srf.knots_v[v_span]) / (float)tile.resolution;
+
+            for (size_t a = 0; a < tile.resolution; ++a)
+            {
+                for (size_t b = 0; b < tile.resolution; ++b)
+                {
+                    const glm::vec3 bilinear = 0.25f * (tile.points[a * samples + b] + tile.points[a * samples + b + 1] +
+                                                        tile.points[(a + 1) * samples + b] + tile.points[(a + 1) * samples + b + 1]);
+                    const float u = srf.knots_u[u_span] + ((float)a + 0.5f) * du;
+                    const float v = srf.knots_v[v_span] + ((float)b + 0.5f) * dv;
+                    lod.error = std::max(lod.error, glm::distance(SurfacePoint(context, srf, u, v), bilinear));
+                }
+            }
+        }
+    }
+
+    return lod;
+}
+
+/// @brief Cache Of Several Tessellations Per Surface, Selected By Geometric Error.
+///
+/// Level 0 Of Every Surface Is Built On Add And Never Evicted. Errors Of Levels Never Built Are Predicted From The
+/// Nearest Measured Level Assuming Quadratic Convergence (Halving The Cell Size Quarters The Error). Select Returns The
+/// Coarsest Level Meeting The Tolerance; If It Is Missing, It Is Queued For Background Workers And The Closest Built
+/// Level Is Returned Instead, Preferring Finer Ones. Built Levels Above 0 Are Evicted In LRU Order Once The Cache
+/// Exceeds memory_budget Bytes. A Level That Cannot Fit Next To Every Level 0 Is Dropped After Being Measured Once,
+/// And Select Settles For The Finest Level Below It Instead Of Rebuilding It Every Frame.
+///
+class LODCache
+{
+public:
+    explicit LODCache(const size_t memory_budget, const size_t max_level = 6, const size_t num_threads = 1)
+        : memory_budget_(memory_budget), max_level_(max_level)
+    {
+        for (size_t i = 0; i < std::max<size_t>(1, num_threads); ++i)
+        {
+            workers_.emplace_back([this](const std::stop_token stop_token) { Work(stop_token); });
+        }
+    }
+
+    LODCache(const LODCache&) = delete;
+    LODCache& operator=(const LODCache&) = delete;
+
+    ~LODCache()
+    {
+        {
+            // Queued Levels Are Not Built Anymore, Workers Only Finish The One In Hand.
+            std::lock_guard lock(mutex_);
+            jobs_.clear();
+        }
+        for (auto& worker : workers_)
+        {
+            worker.request_stop();
+        }
+        workers_.clear();
+    }
+
+    /// @brief Register A Surface And Build Its Level 0 Synchronously. Weights Must Be Positive.
+    /// @return Id Of The Surface.
+    size_t Add(tinynurbs::RationalSurface<float> srf)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->srf = std::move(srf);
+        entry->levels.resize(max_level_ + 1);
+        entry->errors.resize(max_level_ + 1, -1.0f);
+        entry->pending.resize(max_level_ + 1, false);
+        entry->oversized.resize(max_level_ + 1, false);
+        entry->lru_positions.resize(max_level_ + 1);
+
+        // The Control Points Contain The Surface For Positive Weights (Convex Hull Property), Samples Of It Do Not.
+        assert(std::all_of(entry->srf.weights.data(), entry->srf.weights.data() + entry->srf.weights.rows() * entry->srf.weights.cols(),
+                           [](const float weight) { return weight > 0.0f; }));
+        for (size_t i = 0; i < entry->srf.control_points.rows(); ++i)
+        {
+            for (size_t j = 0; j < entry->srf.control_points.cols(); ++j)
+            {
+                entry->bounding_box.Expand(entry->srf.control_points(i, j));
+            }
+        }
+
+        auto lod = std::make_shared<const SurfaceLOD>(TessellateLOD(entry->srf, 0));
+
+        std::lock_guard lock(mutex_);
+        memory_usage_ += lod->Bytes();
+        pinned_usage_ += lod->Bytes();
+        entry->errors[0] = lod->error;
+        entry->levels[0] = std::move(lod);
+        entries_.push_back(std::move(entry));
+        return entries_.size() - 1;
+    }
+
+    [[nodiscard]] size_t Size() const
+    {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+    [[nodiscard]] BoundingBox Bounds(const size_t id) const
+    {
+        std::lock_guard lock(mutex_);
+        return entries_[id]->bounding_box;
+    }
+
+    [[nodiscard]] size_t MemoryUsage() const
+    {
+        std::lock_guard lock(mutex_);
+        return memory_usage_;
+    }
+
+    /// @brief Number Of Levels Built In The Background So Far.
+    [[nodiscard]] size_t NumBuilt() const
+    {
+        std::lock_guard lock(mutex_);
+        return num_built_;
+    }
+
+    /// @brief Measured Error Of A Level Built At Least Once, Else The Predicted One.
+    [[nodiscard]] float Error(const size_t id, const size_t level) const
+    {
+        std::lock_guard lock(mutex_);
+        return Error(*entries_[id], level);
+    }
+
+    /// @brief Best Available Tessellation Of Surface id For A World Space tolerance.
+    /// The Result Stays Valid After Eviction.
+    std::shared_ptr<const SurfaceLOD> Select(const size_t id, const float tolerance)
+    {
+        std::lock_guard lock(mutex_);
+        Entry& entry = *entries_[id];
+
+        size_t wanted = max_level_;
+        for (size_t level = 0; level <= max_level_; ++level)
+        {
+            if (Error(entry, level) <= tolerance)
+            {
+                wanted = level;
+                break;
+            }
+        }
+        while (wanted > 0 && entry.oversized[wanted])
+        {
+            --wanted;
+        }
+
+        if (!entry.levels[wanted] && !entry.pending[wanted])
+        {
+            entry.pending[wanted] = true;
+            jobs_.emplace_back(id, wanted);
+            job_condition_.notify_one();
+        }
+
+        for (size_t level = wanted; level <= max_level_; ++level)
+        {
+            if (entry.levels[level])
+            {
+                return Touch(entry, level);
+            }
+        }
+        for (size_t level = wanted; level-- > 0;)
+        {
+            if (entry.levels[level])
+            {
+                return Touch(entry, level);
+            }
+        }
+        return entry.levels[0];
+    }
+
+    /// @brief Block Until Every Queued Level Is Built.
+    void Wait()
+    {
+        std::unique_lock lock(mutex_);
+        idle_condition_.wait(lock, [this] { return jobs_.empty() && busy_ == 0; });
+    }
+
+private:
+    struct Entry
+    {
+        tinynurbs::RationalSurface<float> srf;
+        BoundingBox bounding_box;
+        std::vector<std::shared_ptr<const SurfaceLOD>> levels;
+        std::vector<float> errors; // Negative If Never Measured. Kept After Eviction.
+        std::vector<bool> pending;
+        std::vector<bool> oversized; // Built Once, But Too Large For The Budget Next To Every Level 0.
+        std::vector<std::list<std::pair<size_t, size_t>>::iterator> lru_positions;
+    };
+
+    [[nodiscard]] float Error(const Entry& entry, const size_t level) const
+    {
+        if (entry.errors[level] >= 0.0f)
+        {
+            return entry.errors[level];
+        }
+
+        // Nearest Measured Level, The Finer One On Ties. Level 0 Is Always Measured.
+        size_t nearest = 0;
+        ptrdiff_t nearest_distance = (ptrdiff_t)level;
+        for (size_t measured = 1; measured <= max_level_; ++measured)
+        {
+            const ptrdiff_t distance = std::abs((ptrdiff_t)measured - (ptrdiff_t)level);
+            if (entry.errors[measured] >= 0.0f && distance <= nearest_distance)
+            {
+                nearest = measured;
+                nearest_distance = distance;
+            }
+        }
+        return entry.errors[nearest] * std::pow(4.0f, (float)nearest - (float)level);
+    }
+
+    std::shared_ptr<const SurfaceLOD> Touch(Entry& entry, const size_t level)
+    {
+        if (level > 0)
+        {
+            lru_.splice(lru_.begin(), lru_, entry.lru_positions[level]);
+        }
+        return entry.levels[level];
+    }
+
+    void Evict()
+    {
+        while (memory_usage_ > memory_budget_ && !lru_.empty())
+        {
+            const auto [id, level] = lru_.back();
+            lru_.pop_back();
+            Entry& entry = *entries_[id];
+            memory_usage_ -= entry.levels[level]->Bytes();
+            entry.levels[level].reset();
+        }
+    }
+
+    void Work(const std::stop_token stop_token)
+    {
+        while (true)
+        {
+            std::unique_lock lock(mutex_);
+            // wait Returns The Predicate, Which May Still Hold After A Stop Request.
+            if (!job_condition_.wait(lock, stop_token, [this] { return !jobs_.empty(); }) || stop_token.stop_requested())
+            {
+                return;
+            }
+
+            const auto [id, level] = jobs_.front();
+            jobs_.pop_front();
+            ++busy_;
+            const Entry& entry = *entries_[id];
+            lock.unlock();
+
+            // The Surface Is Immutable After Add, Build Without Holding The Lock.
+            auto lod = std::make_shared<const SurfaceLOD>(TessellateLOD(entry.srf, level));
+
+            lock.lock();
+            Entry& built = *entries_[id];
+            ++num_built_;
+            built.errors[level] = lod->error;
+            built.pending[level] = false;
+            if (pinned_usage_ + lod->Bytes() > memory_budget_)
+            {
+                // Evicting Everything Else Would Not Make Room, Keep Only The Measured Error.
+                built.oversized[level] = true;
+            }
+            else
+            {
+                memory_usage_ += lod->Bytes();
+                built.levels[level] = std::move(lod);
+                lru_.emplace_front(id, level);
+                built.lru_positions[level] = lru_.begin();
+                Evict();
+            }
+            --busy_;
+            idle_condition_.notify_all();
+        }
+    }
+
+    const size_t memory_budget_;
+    const size_t max_level_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any job_condition_;
+    std::condition_variable idle_condition_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::list<std::pair<size_t, size_t>> lru_;
+    std::deque<std::pair<size_t, size_t>> jobs_;
+    size_t busy_ = 0;
+    size_t memory_usage_ = 0;
+    size_t pinned_usage_ = 0; // Level 0 Of Every Surface, Never Evicted.
+    size_t num_built_ = 0;
+
+    // Last Member, So Workers Are Joined Before Anything They Use Is Destroyed.
+    std::vector<std::jthread> workers_;
+};
+
+}
+
+#endif //LOD_CACHE_H
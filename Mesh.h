@@ -0,0 +1,546 @@
+/**
+  ******************************************************************************
+  * @file           : Mesh.h
+  * @author         : AliceRemake
+  * @brief          : Indexed Mesh Building And Streaming Binary PLY Output
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Tessellation.h>
+
+namespace NURBS
+{
+
+/// @brief New Vertices first_vertex, first_vertex + 1, ... And Triangles, Whose indices May Refer To Vertices Of Any
+/// Chunk Emitted So Far. Triangles Are Counter Clockwise Around The Normal cross(S_v, S_u).
+struct MeshChunk
+{
+    uint32_t first_vertex = 0;
+    std::vector<glm::vec3> points;
+    std::vector<glm::vec3> normals;
+    std::vector<uint32_t> indices;
+};
+
+/// @brief Whole Mesh In Memory, Collected From Chunks.
+struct IndexedMesh
+{
+    std::vector<glm::vec3> points;
+    std::vector<glm::vec3> normals;
+    std::vector<uint32_t> indices;
+
+    void Append(const MeshChunk& chunk)
+    {
+        assert(chunk.first_vertex == points.size());
+        points.insert(points.end(), chunk.points.begin(), chunk.points.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        indices.insert(indices.end(), chunk.indices.begin(), chunk.indices.end());
+    }
+};
+
+/// @brief Builds One Indexed Triangle Mesh From Surface Tiles, Handing It To sink Chunk By Chunk.
+///
+/// Tiles Of A Surface Share The Samples On Their Common Borders: A Border Vertex Waits In A Seam Table Until Every
+/// Tile Touching It Has Been Added, So Tiles May Arrive In Any Order And Only The Open Seams Stay In Memory. Vertices On
+/// The Boundary Of A Surface Are Also Welded To Earlier Ones Within weld_tolerance With Agreeing Normals, Joining
+/// Adjacent Surfaces (And Collapsed Edges Such As Poles). Those Are Kept While Their Surface Is Open And Until
+/// weld_window More Surfaces Have Been Completed, So Only Surfaces Close In Input Order Are Joined And Memory Stays
+/// Bounded However Many Surfaces Stream Through.
+///
+/// AddTile Is Thread Safe, Chunks Are Emitted In Order.
+///
+class MeshBuilder
+{
+public:
+    using Sink = std::function<void(const MeshChunk&)>;
+
+    /// @brief Normals Of Welded Vertices Must Be At Least This Close (Cosine), So Creases Stay Sharp.
+    static constexpr float WeldCosine = 0.99f;
+
+    explicit MeshBuilder(Sink sink, const float weld_tolerance = 0.0f, const size_t chunk_size = 65536, const size_t weld_window = 16)
+        : sink_(std::move(sink)), weld_tolerance_(weld_tolerance), chunk_size_(chunk_size), weld_window_(weld_window)
+    {}
+
+    /// @brief Register srf, Tessellated resolution x resolution Per Knot Span Tile.
+    /// @return Index Of The Surface For AddTile.
+    size_t AddSurface(const tinynurbs::RationalSurface<float>& srf, const size_t resolution)
+    {
+        assert(resolution > 0);
+
+        std::lock_guard lock(mutex_);
+        auto& info = surfaces_.emplace_back();
+        info.u_spans = KnotSpans(srf.degree_u, srf.knots_u);
+        info.v_spans = KnotSpans(srf.degree_v, srf.knots_v);
+        info.resolution = resolution;
+        info.remaining_tiles = info.u_spans.size() * info.v_spans.size();
+        return surfaces_.size() - 1;
+    }
+
+    /// @brief Add A Tile Evaluated By TessellateTile With The Resolution Of Its Surface.
+    void AddTile(const size_t surface, const SurfaceTile& tile)
+    {
+        std::lock_guard lock(mutex_);
+
+        Surface& info = surfaces_[surface];
+        assert(info.remaining_tiles > 0);
+        const size_t resolution = info.resolution;
+        const size_t samples = resolution + 1;
+        assert(tile.resolution == resolution && tile.points.size() == samples * samples);
+
+        const size_t tile_u = std::ranges::lower_bound(info.u_spans, tile.u_span) - info.u_spans.begin();
+        const size_t tile_v = std::ranges::lower_bound(info.v_spans, tile.v_span) - info.v_spans.begin();
+        const size_t grid_u = info.u_spans.size() * resolution;
+        const size_t grid_v = info.v_spans.size() * resolution;
+
+        // Number Of Tiles Sharing Grid Line g: Two On Inner Tile Borders.
+        const auto sharing = [resolution](const size_t g, const size_t grid) -> size_t
+        {
+            return g % resolution == 0 && g > 0 && g < grid ? 2 : 1;
+        };
+
+        vertices_.resize(samples * samples);
+
+        for (size_t a = 0; a < samples; ++a)
+        {
+            for (size_t b = 0; b < samples; ++b)
+            {
+                const size_t k = a * samples + b;
+                const glm::vec3& point = tile.points[k];
+                const glm::vec3& normal = tile.normals[k];
+
+                if (a != 0 && a != resolution && b != 0 && b != resolution)
+                {
+                    vertices_[k] = NewVertex(point, normal);
+                    continue;
+                }
+
+                const size_t g_u = tile_u * resolution + a;
+                const size_t g_v = tile_v * resolution + b;
+                const SeamKey key{ surface, g_u, g_v };
+
+                if (const auto it = seams_.find(key); it != seams_.end())
+                {
+                    vertices_[k] = it->second.index;
+                    if (--it->second.remaining == 0)
+                    {
+                        seams_.erase(it);
+                    }
+                    continue;
+                }
+
+                const bool boundary = g_u == 0 || g_u == grid_u || g_v == 0 || g_v == grid_v;
+                vertices_[k] = boundary && weld_tolerance_ > 0.0f ? Weld(surface, point, normal) : NewVertex(point, normal);
+
+                if (const size_t tiles = sharing(g_u, grid_u) * sharing(g_v, grid_v); tiles > 1)
+                {
+                    seams_.emplace(key, Seam{ vertices_[k], tiles - 1 });
+                }
+            }
+        }
+
+        for (size_t a = 0; a < resolution; ++a)
+        {
+            for (size_t b = 0; b < resolution; ++b)
+            {
+                const uint32_t v00 = vertices_[a * samples + b];
+                const uint32_t v01 = vertices_[a * samples + b + 1];
+                const uint32_t v10 = vertices_[(a + 1) * samples + b];
+                const uint32_t v11 = vertices_[(a + 1) * samples + b + 1];
+                AddTriangle(v00, v01, v11);
+                AddTriangle(v00, v11, v10);
+            }
+        }
+
+        if (--info.remaining_tiles == 0)
+        {
+            Complete(surface);
+        }
+
+        if (chunk_.points.size() >= chunk_size_)
+        {
+            FlushLocked();
+        }
+    }
+
+    /// @brief Register srf And Add All Its Tiles.
+    void Add(const tinynurbs::RationalSurface<float>& srf, const size_t resolution)
+    {
+        const size_t surface = AddSurface(srf, resolution);
+
+        SurfaceTile tile;
+        tile.resolution = resolution;
+        for (const size_t u_span : KnotSpans(srf.degree_u, srf.knots_u))
+        {
+            for (const size_t v_span : KnotSpans(srf.degree_v, srf.knots_v))
+            {
+                tile.u_span = u_span;
+                tile.v_span = v_span;
+                TessellateTile(srf, tile);
+                AddTile(surface, tile);
+            }
+        }
+    }
+
+    /// @brief Emit The Pending Chunk, If Any.
+    void Flush()
+    {
+        std::lock_guard lock(mutex_);
+        FlushLocked();
+    }
+
+    [[nodiscard]] size_t NumVertices() const
+    {
+        std::lock_guard lock(mutex_);
+        return num_vertices_;
+    }
+
+    [[nodiscard]] size_t NumTriangles() const
+    {
+        std::lock_guard lock(mutex_);
+        return num_triangles_;
+    }
+
+    /// @brief Surface Boundary Vertices Later Surfaces Can Still Be Welded To.
+    [[nodiscard]] size_t NumWeldVertices() const
+    {
+        std::lock_guard lock(mutex_);
+        return num_weld_vertices_;
+    }
+
+    /// @brief Border Vertices Still Waiting For A Neighbouring Tile.
+    [[nodiscard]] size_t NumOpenSeamVertices() const
+    {
+        std::lock_guard lock(mutex_);
+        return seams_.size();
+    }
+
+private:
+    using Cell = std::array<long long, 3>;
+
+    struct CellHash
+    {
+        size_t operator()(const Cell& cell) const noexcept
+        {
+            return std::hash<long long>()((cell[0] * 73856093ll) ^ (cell[1] * 19349663ll) ^ (cell[2] * 83492791ll));
+        }
+    };
+
+    struct Surface
+    {
+        std::vector<size_t> u_spans;
+        std::vector<size_t> v_spans;
+        size_t resolution = 0;
+        size_t remaining_tiles = 0;
+        std::vector<Cell> weld_cells; // Where Its Weld Vertices Are, Once Per Vertex.
+    };
+
+    struct SeamKey
+    {
+        size_t surface;
+        size_t u;
+        size_t v;
+
+        bool operator==(const SeamKey&) const = default;
+    };
+
+    struct SeamHash
+    {
+        size_t operator()(const SeamKey& key) const noexcept
+        {
+            return std::hash<size_t>()((key.surface * 0x9E3779B97F4A7C15ull ^ key.u) * 0x9E3779B97F4A7C15ull ^ key.v);
+        }
+    };
+
+    struct Seam
+    {
+        uint32_t index;
+        size_t remaining;
+    };
+
+    struct WeldVertex
+    {
+        glm::vec3 point;
+        glm::vec3 normal;
+        uint32_t index;
+        size_t surface;
+    };
+
+    uint32_t NewVertex(const glm::vec3& point, const glm::vec3& normal)
+    {
+        assert(num_vertices_ < std::numeric_limits<uint32_t>::max());
+        chunk_.points.push_back(point);
+        chunk_.normals.push_back(normal);
+        return (uint32_t)num_vertices_++;
+    }
+
+    /// @brief Existing Vertex Within weld_tolerance_ Of point In One Of The 27 Cells Around It, Or A New One.
+    uint32_t Weld(const size_t surface, const glm::vec3& point, const glm::vec3& normal)
+    {
+        const Cell cell = {
+            (long long)std::floor(point.x / weld_tolerance_),
+            (long long)std::floor(point.y / weld_tolerance_),
+            (long long)std::floor(point.z / weld_tolerance_),
+        };
+
+        for (long long x = -1; x <= 1; ++x)
+        {
+            for (long long y = -1; y <= 1; ++y)
+            {
+                for (long long z = -1; z <= 1; ++z)
+                {
+                    const auto it = welds_.find({ cell[0] + x, cell[1] + y, cell[2] + z });
+                    if (it == welds_.end())
+                    {
+                        continue;
+                    }
+                    for (const WeldVertex& vertex : it->second)
+                    {
+                        const bool undefined_normal = normal == glm::vec3(0.0f) || vertex.normal == glm::vec3(0.0f);
+                        if (glm::distance(vertex.point, point) <= weld_tolerance_ &&
+                            (undefined_normal || glm::dot(vertex.normal, normal) >= WeldCosine))
+                        {
+                            return vertex.index;
+                        }
+                    }
+                }
+            }
+        }
+
+        const uint32_t index = NewVertex(point, normal);
+        welds_[cell].push_back({ point, normal, index, surface });
+        surfaces_[surface].weld_cells.push_back(cell);
+        ++num_weld_vertices_;
+        return index;
+    }
+
+    /// @brief All Tiles Of surface Were Added: Release Its Spans, And The Weld Vertices Of The Surface Completed
+    /// weld_window Surfaces Before It.
+    void Complete(const size_t surface)
+    {
+        Surface& info = surfaces_[surface];
+        std::vector<size_t>().swap(info.u_spans);
+        std::vector<size_t>().swap(info.v_spans);
+        completed_.push_back(surface);
+
+        while (completed_.size() > weld_window_)
+        {
+            Surface& oldest = surfaces_[completed_.front()];
+            for (const Cell& cell : oldest.weld_cells)
+            {
+                const auto it = welds_.find(cell);
+                if (it == welds_.end())
+                {
+                    continue;
+                }
+                const size_t erased = std::erase_if(it->second, [&](const WeldVertex& vertex) { return vertex.surface == completed_.front(); });
+                num_weld_vertices_ -= erased;
+                if (it->second.empty())
+                {
+                    welds_.erase(it);
+                }
+            }
+            std::vector<Cell>().swap(oldest.weld_cells);
+            completed_.pop_front();
+        }
+    }
+
+    /// @brief Triangles Collapsed By Welding Are Dropped.
+    void AddTriangle(const uint32_t v0, const uint32_t v1, const uint32_t v2)
+    {
+        if (v0 == v1 || v1 == v2 || v2 == v0)
+        {
+            return;
+        }
+        chunk_.indices.insert(chunk_.indices.end(), { v0, v1, v2 });
+        ++num_triangles_;
+    }
+
+    void FlushLocked()
+    {
+        if (chunk_.points.empty() && chunk_.indices.empty())
+        {
+            return;
+        }
+        sink_(chunk_);
+        chunk_.first_vertex = (uint32_t)num_vertices_;
+        chunk_.points.clear();
+        chunk_.normals.clear();
+        chunk_.indices.clear();
+    }
+
+    Sink sink_;
+    float weld_tolerance_;
+    size_t chunk_size_;
+    size_t weld_window_;
+
+    mutable std::mutex mutex_;
+    std::vector<Surface> surfaces_;
+    std::unordered_map<SeamKey, Seam, SeamHash> seams_;
+    std::unordered_map<Cell, std::vector<WeldVertex>, CellHash> welds_;
+    std::deque<size_t> completed_; // The Last weld_window Completed Surfaces, Whose Weld Vertices Are Kept.
+    size_t num_weld_vertices_ = 0;
+    MeshChunk chunk_;
+    std::vector<uint32_t> vertices_;
+    size_t num_vertices_ = 0;
+    size_t num_triangles_ = 0;
+};
+
+/// @brief Writes Mesh Chunks To A Binary PLY File As They Arrive (Vertex x y z nx ny nz, Face uchar + uint List).
+///
+/// PLY Stores All Vertices Before All Faces, So Faces Go To A Side File Which Close Appends; The Header Reserves
+/// Fixed Width Counts That Close Fills In. Only One Chunk Is Ever Held In Memory.
+///
+class PLYWriter
+{
+public:
+    explicit PLYWriter(std::filesystem::path path)
+        : path_(std::move(path)), faces_path_(path_.string() + ".faces"),
+          file_(path_, std::ios::binary), faces_(faces_path_, std::ios::binary)
+    {
+        if (!file_ || !faces_)
+        {
+            throw std::runtime_error("PLYWriter: Cannot Open " + path_.string());
+        }
+        WriteHeader();
+    }
+
+    PLYWriter(const PLYWriter&) = delete;
+    PLYWriter& operator=(const PLYWriter&) = delete;
+
+    ~PLYWriter()
+    {
+        try
+        {
+            Close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void Write(const MeshChunk& chunk)
+    {
+        assert(chunk.first_vertex == num_vertices_);
+
+        buffer_.clear();
+        for (size_t i = 0; i < chunk.points.size(); ++i)
+        {
+            const std::array vertex = {
+                chunk.points[i].x, chunk.points[i].y, chunk.points[i].z,
+                chunk.normals[i].x, chunk.normals[i].y, chunk.normals[i].z,
+            };
+            Append(vertex);
+        }
+        file_.write(buffer_.data(), (std::streamsize)buffer_.size());
+
+        buffer_.clear();
+        for (size_t i = 0; i < chunk.indices.size(); i += 3)
+        {
+            buffer_.push_back((char)3);
+            Append(std::array{ chunk.indices[i], chunk.indices[i+1], chunk.indices[i+2] });
+        }
+        faces_.write(buffer_.data(), (std::streamsize)buffer_.size());
+
+        if (!file_ || !faces_)
+        {
+            throw std::runtime_error("PLYWriter: Cannot Write " + path_.string());
+        }
+
+        num_vertices_ += chunk.points.size();
+        num_faces_ += chunk.indices.size() / 3;
+    }
+
+    /// @brief Finish The File. Called By The Destructor If Needed.
+    void Close()
+    {
+        if (!file_.is_open())
+        {
+            return;
+        }
+
+        faces_.close();
+        if (num_faces_ > 0)
+        {
+            std::ifstream faces(faces_path_, std::ios::binary);
+            file_ << faces.rdbuf();
+        }
+        std::filesystem::remove(faces_path_);
+
+        file_.seekp(vertex_count_position_);
+        file_ << Count(num_vertices_);
+        file_.seekp(face_count_position_);
+        file_ << Count(num_faces_);
+        file_.close();
+
+        if (!file_)
+        {
+            throw std::runtime_error("PLYWriter: Cannot Write " + path_.string());
+        }
+    }
+
+    [[nodiscard]] size_t NumVertices() const noexcept
+    {
+        return num_vertices_;
+    }
+
+    [[nodiscard]] size_t NumFaces() const noexcept
+    {
+        return num_faces_;
+    }
+
+private:
+    static constexpr int CountWidth = 20;
+
+    static std::string Count(const size_t count)
+    {
+        std::string text = std::to_string(count);
+        text.resize(CountWidth, ' ');
+        return text;
+    }
+
+    void WriteHeader()
+    {
+        file_ << "ply\n";
+        file_ << (std::endian::native == std::endian::little ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n");
+        file_ << "element vertex ";
+        vertex_count_position_ = file_.tellp();
+        file_ << Count(0) << "\n";
+        file_ << "property float x\nproperty float y\nproperty float z\n";
+        file_ << "property float nx\nproperty float ny\nproperty float nz\n";
+        file_ << "element face ";
+        face_count_position_ = file_.tellp();
+        file_ << Count(0) << "\n";
+        file_ << "property list uchar uint vertex_indices\n";
+        file_ << "end_header\n";
+    }
+
+    template <typename T, size_t N>
+    void Append(const std::array<T, N>& values)
+    {
+        const auto* bytes = reinterpret_cast<const char*>(values.data());
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T) * N);
+    }
+
+    std::filesystem::path path_;
+    std::filesystem::path faces_path_;
+    std::ofstream file_;
+    std::ofstream faces_;
+    std::streampos vertex_count_position_;
+    std::streampos face_count_position_;
+    std::vector<char> buffer_;
+    size_t num_vertices_ = 0;
+    size_t num_faces_ = 0;
+};
+
+}
+
+#endif //MESH_H
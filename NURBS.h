@@ -27,7 +27,54 @@ inline size_t FindSpan(const size_t degree, const std::vector<float>& knots, con
     return (size_t)(std::upper_bound(knots.begin() + (long long)degree + 1, knots.end() - (long long)degree - 1, u) - knots.begin() - 1);
 }
 
-/// @brief Compute Nonzero B-Spline Basis Functions.
+/// @brief Distinct Knot Values Bounding The Nonempty Spans.
+template <typename T>
+std::vector<T> Breakpoints(const size_t degree, const std::vector<T>& knots)
+{
+    std::vector<T> breakpoints(knots.begin() + (long long)degree, knots.end() - (long long)degree);
+    breakpoints.erase(std::unique(breakpoints.begin(), breakpoints.end()), breakpoints.end());
+    return breakpoints;
+}
+
+/// @brief Reusable Scratch Memory For Evaluation.
+///
+/// Every Buffer Is Allocated From resource And Only Ever Grows, So Once A Context Has Seen The Largest Degree And
+/// Derivative Order In Use, Evaluating Through It Performs Zero Heap Allocations. resource Can Be A Per Thread
+/// std::pmr::monotonic_buffer_resource (Bump Arena) To Keep Even The Warm Up Off The Global Allocator.
+/// A Context Is Not Thread Safe. Use One Per Thread.
+///
+struct EvaluationContext
+{
+    explicit EvaluationContext(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : left(resource), right(resource), ndu(resource), a(resource),
+          u_b_spline_basis(resource), v_b_spline_basis(resource), homo_derivatives(resource), temp(resource)
+    {}
+
+    /// @brief View Of The First size Elements Of buffer, Growing It If Needed.
+    template <typename T>
+    static std::span<T> Acquire(std::pmr::vector<T>& buffer, const size_t size)
+    {
+        if (buffer.size() < size)
+        {
+            buffer.resize(size);
+        }
+        return std::span<T>(buffer.data(), size);
+    }
+
+    // Scratch Of BSplineBasis And BSplineDerBasis.
+    std::pmr::vector<float> left;
+    std::pmr::vector<float> right;
+    std::pmr::vector<float> ndu;
+    std::pmr::vector<float> a;
+
+    // Scratch Of Curve And Surface Evaluation.
+    std::pmr::vector<float> u_b_spline_basis;
+    std::pmr::vector<float> v_b_spline_basis;
+    std::pmr::vector<glm::vec4> homo_derivatives;
+    std::pmr::vector<glm::vec4> temp;
+};
+
+/// @brief Compute Nonzero B-Spline Basis Functions Into b_spline_basis, Which Must Hold degree + 1 Floats.
 ///
 ///    0         1            d     <--Index In b_spline_basis
 /// [span  ]                        degree=0
@@ -50,11 +97,12 @@ inline size_t FindSpan(const size_t degree, const std::vector<float>& knots, con
 /// FOR SAME `p`. THE TERM ------------------- CAN BE REUSE.
 ///                        u_{i+p+1} - u_{i+1}
 ///
-inline std::vector<float> BSplineBasis(const size_t degree, const size_t span, const std::vector<float>& knots, const float u) noexcept
+inline void BSplineBasis(EvaluationContext& context, const size_t degree, const size_t span, const std::span<const float> knots, const float u, const std::span<float> b_spline_basis)
 {
-    std::vector<float> b_spline_basis(degree + 1);
-    std::vector<float> left(degree + 1);
-    std::vector<float> right(degree + 1);
+    assert(b_spline_basis.size() >= degree + 1);
+
+    const auto left = EvaluationContext::Acquire(context.left, degree + 1);
+    const auto right = EvaluationContext::Acquire(context.right, degree + 1);
 
     b_spline_basis[0] = 1.0f; // N_{span,0} = 1.0f.
     
@@ -77,22 +125,33 @@ inline std::vector<float> BSplineBasis(const size_t degree, const size_t span, c
         // The Second Term Of The Last Nonzero B-Spline Basis Function Is 0.0f.
         b_spline_basis[d] = first_term;
     }
+}
 
+/// @brief Compute Nonzero B-Spline Basis Functions.
+inline std::vector<float> BSplineBasis(const size_t degree, const size_t span, const std::vector<float>& knots, const float u) noexcept
+{
+    EvaluationContext context;
+    std::vector<float> b_spline_basis(degree + 1);
+    BSplineBasis(context, degree, span, knots, u, b_spline_basis);
     return b_spline_basis;
 }
 
-/// @brief Compute Nonzero Derivatives Of B-Spline Basis Functions.
+/// @brief Compute Nonzero Derivatives Of B-Spline Basis Functions Into b_spline_der_basis, Which Must Hold
+/// (num_ders + 1) x (degree + 1) Floats In Row Major Order, Row k Is The k-th Derivative.
 ///
 /// LET: ndu[i][j] = N_{span+i-j,j}.                i <= j.
 /// LET: ndu[i][j] = u_{span+1+j} - u_{span+1-i+j}. i >  j.
 /// 
-inline std::vector<std::vector<float>> BSplineDerBasis(const size_t degree, const size_t span, const std::vector<float>& knots, const float u, const size_t num_ders)
+inline void BSplineDerBasis(EvaluationContext& context, const size_t degree, const size_t span, const std::span<const float> knots, const float u, const size_t num_ders, const std::span<float> b_spline_der_basis)
 {
-    std::vector ndu(degree + 1, std::vector<float>(degree + 1));
-    std::vector<float> left(degree + 1);
-    std::vector<float> right(degree + 1);
+    assert(b_spline_der_basis.size() >= (num_ders + 1) * (degree + 1));
+
+    const size_t n = degree + 1;
+    const auto ndu = EvaluationContext::Acquire(context.ndu, n * n);
+    const auto left = EvaluationContext::Acquire(context.left, degree + 1);
+    const auto right = EvaluationContext::Acquire(context.right, degree + 1);
 
-    ndu[0][0] = 1.0f; // N_{span,0} = 1.0f.
+    ndu[0] = 1.0f; // N_{span,0} = 1.0f.
     
     for (size_t d = 1; d <= degree; ++d) // Loop Over Degree From `1` To `degree`.
     {
@@ -105,31 +164,34 @@ inline std::vector<std::vector<float>> BSplineDerBasis(const size_t degree, cons
 
         for (size_t i = 0; i < d; ++i)
         {
-            ndu[d][i] = right[i+1] + left[d-i];
-            reused_term = ndu[i][d-1] / (left[d-i] + right[i+1]);
-            ndu[i][d] = first_term + right[i+1] * reused_term;
+            ndu[d*n+i] = right[i+1] + left[d-i];
+            reused_term = ndu[i*n+d-1] / (left[d-i] + right[i+1]);
+            ndu[i*n+d] = first_term + right[i+1] * reused_term;
             first_term = left[d-i] * reused_term;
         }
 
         // The Second Term Of The Last Nonzero B-Spline Basis Function Is 0.0f.
-        ndu[d][d] = first_term;
+        ndu[d*n+d] = first_term;
     }
 
-    std::vector b_spline_der_basis(num_ders + 1, std::vector(degree + 1, 0.0f));
+    std::fill_n(b_spline_der_basis.begin(), (num_ders + 1) * n, 0.0f);
 
     // 0-th Derivatives Is Basis Functions.
     for (size_t i = 0; i <= degree; ++i)
     {
-        b_spline_der_basis[0][i] = ndu[i][degree];
+        b_spline_der_basis[i] = ndu[i*n+degree];
     }
 
+    // a[s][j] Is a[s*m+j].
+    const size_t m = num_ders + 1;
+    const auto a = EvaluationContext::Acquire(context.a, 2 * m);
+
     for (size_t d = 0; d <= degree; ++d) // Loop Over Degree.
     {
-        int s1 = 0;
-        int s2 = 1;
-        std::vector a(2, std::vector<float>(num_ders + 1));
+        size_t s1 = 0;
+        size_t s2 = 1;
 
-        a[s1][0] = 1.0f; // a_{k-1,0} = a_{0,0} = 1.0f;
+        a[s1*m] = 1.0f; // a_{k-1,0} = a_{0,0} = 1.0f;
         
         for (size_t k = 1; k <= std::min(degree, num_ders); ++k) // Loop Over k-th Derivative.
         {
@@ -138,22 +200,22 @@ inline std::vector<std::vector<float>> BSplineDerBasis(const size_t degree, cons
             // Calc a_{k, 0}
             if (d >= k)
             {
-                a[s2][0] = a[s1][0] / ndu[degree-k+1][d-k];
-                derivative = a[s2][0] * ndu[d-k][degree-k];
+                a[s2*m] = a[s1*m] / ndu[(degree-k+1)*n+d-k];
+                derivative = a[s2*m] * ndu[(d-k)*n+degree-k];
             }
-            // Calc a_{k,j}
-            for (size_t j = std::max(1ull, k-d); j <= std::min(k-1, degree-d); ++j)
+            // Calc a_{k,j}. Start At max(1, k-d) Without Wrapping Around When d > k.
+            for (size_t j = k > d ? k-d : 1; j <= std::min(k-1, degree-d); ++j)
             {
-                a[s2][j] = (a[s1][j] - a[s1][j-1]) / ndu[degree-k+1][d-k+j];
-                derivative += a[s2][j] * ndu[d-k+j][degree-k];
+                a[s2*m+j] = (a[s1*m+j] - a[s1*m+j-1]) / ndu[(degree-k+1)*n+d-k+j];
+                derivative += a[s2*m+j] * ndu[(d-k+j)*n+degree-k];
             }
             // Calc a_{k,k}
             if (d <= degree - k)
             {
-                a[s2][k] = -a[s1][k-1] / ndu[degree-k+1][d];
-                derivative += a[s2][k] * ndu[d][degree-k];
+                a[s2*m+k] = -a[s1*m+k-1] / ndu[(degree-k+1)*n+d];
+                derivative += a[s2*m+k] * ndu[d*n+degree-k];
             }
-            b_spline_der_basis[k][d] = derivative;
+            b_spline_der_basis[k*n+d] = derivative;
             // Flip.
             std::swap(s1, s2);
         }
@@ -164,53 +226,62 @@ inline std::vector<std::vector<float>> BSplineDerBasis(const size_t degree, cons
         // degree * (degree-1) * ... * (degree-k+1)
         for (size_t d = 0; d <= degree; ++d)
         {
-            b_spline_der_basis[k][d] *= (float)factor;
+            b_spline_der_basis[k*n+d] *= (float)factor;
         }
     }
-    
-    return b_spline_der_basis;
 }
 
-inline glm::vec3 CurvePoint(const tinynurbs::RationalCurve<float>& crv, const float u)
+/// @brief Compute Nonzero Derivatives Of B-Spline Basis Functions.
+inline std::vector<std::vector<float>> BSplineDerBasis(const size_t degree, const size_t span, const std::vector<float>& knots, const float u, const size_t num_ders)
 {
-    const size_t span = FindSpan(crv.degree, crv.knots, u);
-
-    const auto b_spline_basis = BSplineBasis(crv.degree, span, crv.knots, u);
+    EvaluationContext context;
+    std::vector<float> flat((num_ders + 1) * (degree + 1));
+    BSplineDerBasis(context, degree, span, knots, u, num_ders, flat);
 
-    std::vector<glm::vec4> homo_control_points(crv.control_points.size());
+    std::vector b_spline_der_basis(num_ders + 1, std::vector(degree + 1, 0.0f));
 
-    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    for (size_t k = 0; k <= num_ders; ++k)
     {
-        homo_control_points[i] = glm::vec4(crv.control_points[i] * crv.weights[i], crv.weights[i]);
+        std::copy_n(flat.begin() + (long long)(k * (degree + 1)), degree + 1, b_spline_der_basis[k].begin());
     }
+    
+    return b_spline_der_basis;
+}
+
+/// @brief Only The degree + 1 Control Points Around span Are Lifted To Homogeneous Coordinates.
+inline glm::vec3 CurvePoint(EvaluationContext& context, const tinynurbs::RationalCurve<float>& crv, const float u)
+{
+    const size_t span = FindSpan(crv.degree, crv.knots, u);
+
+    const auto b_spline_basis = EvaluationContext::Acquire(context.u_b_spline_basis, crv.degree + 1);
+    BSplineBasis(context, crv.degree, span, crv.knots, u, b_spline_basis);
 
     glm::vec4 point(0.0f);
 
     for (size_t i = 0; i < b_spline_basis.size(); ++i)
     {
-        point += b_spline_basis[i] * homo_control_points[span-crv.degree+i];
+        const size_t index = span - crv.degree + i;
+        point += b_spline_basis[i] * glm::vec4(crv.control_points[index] * crv.weights[index], crv.weights[index]);
     }
 
     return glm::vec3(point) / point.w;
 }
 
-inline glm::vec3 SurfacePoint(const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
+inline glm::vec3 CurvePoint(const tinynurbs::RationalCurve<float>& crv, const float u)
+{
+    EvaluationContext context;
+    return CurvePoint(context, crv, u);
+}
+
+inline glm::vec3 SurfacePoint(EvaluationContext& context, const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
 {
     const size_t u_span = FindSpan(srf.degree_u, srf.knots_u, u);    
     const size_t v_span = FindSpan(srf.degree_v, srf.knots_v, v);
 
-    const auto u_b_spline_basis = BSplineBasis(srf.degree_u, u_span, srf.knots_u, u);
-    const auto v_b_spline_basis = BSplineBasis(srf.degree_v, v_span, srf.knots_v, v);
-
-    std::vector homo_control_points(srf.control_points.rows(), std::vector<glm::vec4>(srf.control_points.cols()));
-
-    for (size_t i = 0; i < srf.control_points.rows(); ++i)
-    {
-        for (size_t j = 0; j < srf.control_points.cols(); ++j)
-        {
-            homo_control_points[i][j] = glm::vec4(srf.control_points(i, j) * srf.weights(i, j), srf.weights(i, j));
-        }
-    }
+    const auto u_b_spline_basis = EvaluationContext::Acquire(context.u_b_spline_basis, srf.degree_u + 1);
+    const auto v_b_spline_basis = EvaluationContext::Acquire(context.v_b_spline_basis, srf.degree_v + 1);
+    BSplineBasis(context, srf.degree_u, u_span, srf.knots_u, u, u_b_spline_basis);
+    BSplineBasis(context, srf.degree_v, v_span, srf.knots_v, v, v_b_spline_basis);
 
     glm::vec4 point(0.0f);
 
@@ -219,7 +290,9 @@ inline glm::vec3 SurfacePoint(const tinynurbs::RationalSurface<float>& srf, cons
         glm::vec4 tmp(0.0f);
         for (size_t j = 0; j < u_b_spline_basis.size(); ++j)
         {
-            tmp += u_b_spline_basis[j] * homo_control_points[u_span-srf.degree_u+j][v_span-srf.degree_v+i];
+            const size_t r = u_span - srf.degree_u + j;
+            const size_t s = v_span - srf.degree_v + i;
+            tmp += u_b_spline_basis[j] * glm::vec4(srf.control_points(r, s) * srf.weights(r, s), srf.weights(r, s));
         }
         point += v_b_spline_basis[i] * tmp;
     }
@@ -227,6 +300,12 @@ inline glm::vec3 SurfacePoint(const tinynurbs::RationalSurface<float>& srf, cons
     return glm::vec3(point) / point.w;
 }
 
+inline glm::vec3 SurfacePoint(const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
+{
+    EvaluationContext context;
+    return SurfacePoint(context, srf, u, v);
+}
+
 // C_n^i
 inline size_t Binomial(const size_t i, const size_t n)
 {
@@ -243,20 +322,18 @@ inline size_t Binomial(const size_t i, const size_t n)
     return ans;
 }
 
-inline std::vector<glm::vec3> CurveDerivatives(const tinynurbs::RationalCurve<float>& crv, const size_t num_ders, const float u)
+/// @brief Compute Curve Derivatives Into ders, Which Must Hold num_ders + 1 Points.
+inline void CurveDerivatives(EvaluationContext& context, const tinynurbs::RationalCurve<float>& crv, const size_t num_ders, const float u, const std::span<glm::vec3> ders)
 {
+    assert(ders.size() >= num_ders + 1);
+
     const size_t span = FindSpan(crv.degree, crv.knots, u);
 
-    std::vector<glm::vec4> homo_control_points(crv.control_points.size());
+    const auto b_spline_der_basis = EvaluationContext::Acquire(context.u_b_spline_basis, (num_ders + 1) * (crv.degree + 1));
+    BSplineDerBasis(context, crv.degree, span, crv.knots, u, num_ders, b_spline_der_basis);
 
-    for (size_t i = 0; i < crv.control_points.size(); ++i)
-    {
-        homo_control_points[i] = glm::vec4(crv.control_points[i] * crv.weights[i], crv.weights[i]);
-    }
-    
-    const auto b_spline_der_basis = BSplineDerBasis(crv.degree, span, crv.knots, u, num_ders);
-    
-    std::vector homo_curve_derivative(num_ders + 1, glm::vec4(0.0f));
+    const auto homo_curve_derivative = EvaluationContext::Acquire(context.homo_derivatives, num_ders + 1);
+    std::fill(homo_curve_derivative.begin(), homo_curve_derivative.end(), glm::vec4(0.0f));
     
     const size_t du = std::min(num_ders, (size_t)crv.degree);
 
@@ -264,141 +341,159 @@ inline std::vector<glm::vec3> CurveDerivatives(const tinynurbs::RationalCurve<fl
     {
         for (size_t j = 0; j <= crv.degree; ++j)
         {
-            homo_curve_derivative[k] += b_spline_der_basis[k][j] *  homo_control_points[span-crv.degree+j];         
+            const size_t index = span - crv.degree + j;
+            homo_curve_derivative[k] += b_spline_der_basis[k*(crv.degree+1)+j] * glm::vec4(crv.control_points[index] * crv.weights[index], crv.weights[index]);
         }
     }
 
-    std::vector<glm::vec3> Aders(homo_curve_derivative.size());
-    std::vector<float> wders(homo_curve_derivative.size());
-
-    for (size_t i = 0; i < homo_curve_derivative.size(); ++i)
-    {
-        Aders[i] = homo_curve_derivative[i];
-        wders[i] = homo_curve_derivative[i].w;
-    }
-
-    std::vector<glm::vec3> ders(num_ders+1);
-
+    // Aders[d] = homo_curve_derivative[d].xyz, wders[d] = homo_curve_derivative[d].w.
     for (size_t d = 0; d <= num_ders; ++d)
     {
-        ders[d] = Aders[d];
+        ders[d] = homo_curve_derivative[d];
         for (size_t i = 1; i <= d; ++i)
         {
-            ders[d] -= Binomial(i, d) * wders[i] * ders[d-i];
+            ders[d] -= Binomial(i, d) * homo_curve_derivative[i].w * ders[d-i];
         }
-        ders[d] /= wders[0];
+        ders[d] /= homo_curve_derivative[0].w;
     }
+}
 
+inline std::vector<glm::vec3> CurveDerivatives(const tinynurbs::RationalCurve<float>& crv, const size_t num_ders, const float u)
+{
+    EvaluationContext context;
+    std::vector<glm::vec3> ders(num_ders+1);
+    CurveDerivatives(context, crv, num_ders, u, ders);
     return ders;
 }
 
-inline std::vector<std::vector<glm::vec3>> SurfaceDerivatives(const tinynurbs::RationalSurface<float>& srf, const size_t num_ders, const float u, const float v)
+/// @brief Compute Surface Derivatives Into ders, Which Must Hold (num_ders + 1) x (num_ders + 1) Points In Row Major
+/// Order, ders[k * (num_ders + 1) + l] Is The k-th Derivative By u And l-th By v.
+inline void SurfaceDerivatives(EvaluationContext& context, const tinynurbs::RationalSurface<float>& srf, const size_t num_ders, const float u, const float v, const std::span<glm::vec3> ders)
 {
+    assert(ders.size() >= (num_ders + 1) * (num_ders + 1));
+
     const size_t u_span = FindSpan(srf.degree_u, srf.knots_u, u);
     const size_t v_span = FindSpan(srf.degree_v, srf.knots_v, v);
 
-    std::vector homo_control_points(srf.control_points.rows(), std::vector<glm::vec4>(srf.control_points.cols()));
-    tinynurbs::array2<glm::vec4> hhomo_control_points(srf.control_points.rows(), srf.control_points.cols());
+    const size_t nu = srf.degree_u + 1;
+    const size_t nv = srf.degree_v + 1;
+    const size_t m = num_ders + 1;
 
-    for (size_t i = 0; i < srf.control_points.rows(); ++i)
-    {
-        for (size_t j = 0; j < srf.control_points.cols(); ++j)
-        {
-            homo_control_points[i][j] = glm::vec4(srf.control_points(i, j) * srf.weights(i, j), srf.weights(i, j));
-            hhomo_control_points(i, j) = homo_control_points[i][j];
-        }
-    }
-
-    auto u_b_spline_der_basis = BSplineDerBasis(srf.degree_u, u_span, srf.knots_u, u, num_ders);
-    auto v_b_spline_der_basis = BSplineDerBasis(srf.degree_v, v_span, srf.knots_v, v, num_ders);
+    const auto u_b_spline_der_basis = EvaluationContext::Acquire(context.u_b_spline_basis, m * nu);
+    const auto v_b_spline_der_basis = EvaluationContext::Acquire(context.v_b_spline_basis, m * nv);
+    BSplineDerBasis(context, srf.degree_u, u_span, srf.knots_u, u, num_ders, u_b_spline_der_basis);
+    BSplineDerBasis(context, srf.degree_v, v_span, srf.knots_v, v, num_ders, v_b_spline_der_basis);
 
     const size_t du = std::min(num_ders, (size_t)srf.degree_u);
     const size_t dv = std::min(num_ders, (size_t)srf.degree_v);
 
-    std::vector homo_surface_derivatives(num_ders + 1, std::vector(num_ders + 1, glm::vec4(0.0f)));
+    const auto homo_surface_derivatives = EvaluationContext::Acquire(context.homo_derivatives, m * m);
+    std::fill(homo_surface_derivatives.begin(), homo_surface_derivatives.end(), glm::vec4(0.0f));
+
+    const auto temp = EvaluationContext::Acquire(context.temp, nv);
     
     for (size_t k = 0; k <= du; ++k)
     {
-        std::vector<glm::vec4> temp(srf.degree_v + 1);
         for (size_t s = 0; s <= srf.degree_v; ++s)
         {
             temp[s] = glm::vec4(0.0);
             for (size_t r = 0; r <= srf.degree_u; ++r)
             {
-                temp[s] += u_b_spline_der_basis[k][r] * homo_control_points[u_span+r-srf.degree_u][v_span+s-srf.degree_v];
+                const size_t i = u_span + r - srf.degree_u;
+                const size_t j = v_span + s - srf.degree_v;
+                temp[s] += u_b_spline_der_basis[k*nu+r] * glm::vec4(srf.control_points(i, j) * srf.weights(i, j), srf.weights(i, j));
             }
         }
         const size_t dd = std::min(num_ders-k, dv);
         for (size_t l = 0; l <= dd; ++l)
         {
-            homo_surface_derivatives[k][l] = glm::vec4(0.0);
+            homo_surface_derivatives[k*m+l] = glm::vec4(0.0);
             for (size_t s = 0; s <= srf.degree_v; ++s)
             {
-                homo_surface_derivatives[k][l] += v_b_spline_der_basis[l][s] * temp[s];
+                homo_surface_derivatives[k*m+l] += v_b_spline_der_basis[l*nv+s] * temp[s];
             }
         }
     }
 
-    auto hhomo_surface_derivatives = tinynurbs::internal::surfaceDerivatives(srf.degree_u, srf.degree_v, srf.knots_u, srf.knots_v, hhomo_control_points, num_ders, u, v);
-    
-    for (size_t i = 0; i < homo_surface_derivatives.size(); ++i)
+#ifndef NDEBUG
+    // Cross Check Against tinynurbs. Debug Builds Only, It Allocates.
+    tinynurbs::array2<glm::vec4> hhomo_control_points(srf.control_points.rows(), srf.control_points.cols());
+
+    for (size_t i = 0; i < srf.control_points.rows(); ++i)
     {
-        for (size_t j = 0; j < homo_surface_derivatives[i].size(); ++j)
+        for (size_t j = 0; j < srf.control_points.cols(); ++j)
         {
-            assert(glm::distance(homo_surface_derivatives[i][j], hhomo_surface_derivatives(i, j)) < 2 * std::numeric_limits<float>::epsilon());
+            hhomo_control_points(i, j) = glm::vec4(srf.control_points(i, j) * srf.weights(i, j), srf.weights(i, j));
         }
     }
 
-    std::vector Aders(homo_surface_derivatives.size(), std::vector<glm::vec3>(homo_surface_derivatives[0].size()));
-    std::vector wders(homo_surface_derivatives.size(), std::vector<float>(homo_surface_derivatives[0].size()));
-
-    for (size_t i = 0; i < homo_surface_derivatives.size(); ++i)
+    auto hhomo_surface_derivatives = tinynurbs::internal::surfaceDerivatives(srf.degree_u, srf.degree_v, srf.knots_u, srf.knots_v, hhomo_control_points, num_ders, u, v);
+    
+    for (size_t i = 0; i < m; ++i)
     {
-        for (size_t j = 0; j < homo_surface_derivatives[i].size(); ++j)
+        for (size_t j = 0; j < m; ++j)
         {
-            Aders[i][j] = homo_surface_derivatives[i][j];
-            wders[i][j] = homo_surface_derivatives[i][j].w;
+            assert(glm::distance(homo_surface_derivatives[i*m+j], hhomo_surface_derivatives(i, j)) < 2 * std::numeric_limits<float>::epsilon());
         }
     }
+#endif
 
-    std::vector ders(num_ders + 1, std::vector(num_ders + 1, glm::vec3(0.0f)));
+    // Aders[k][l] = homo_surface_derivatives[k*m+l].xyz, wders[k][l] = homo_surface_derivatives[k*m+l].w.
+    const auto wders = [&](const size_t k, const size_t l) { return homo_surface_derivatives[k*m+l].w; };
+
+    std::fill_n(ders.begin(), m * m, glm::vec3(0.0f));
 
     for (int k = 0; k <= num_ders; ++k)
     {
         for (int l = 0; l <= num_ders - k; ++l)
         {
-            auto v0 = Aders[k][l];
+            glm::vec3 v0 = homo_surface_derivatives[k*m+l];
 
             for (int j = 1; j <= l; ++j)
             {
-                v0 -= (float)Binomial(j, l) * wders[0][j] * ders[k][l - j];
+                v0 -= (float)Binomial(j, l) * wders(0, j) * ders[k*m+l-j];
             }
 
             for (int i = 1; i <= k; ++i)
             {
-                v0 -= (float)Binomial(i, k) * wders[i][0] * ders[k - i][l];
+                v0 -= (float)Binomial(i, k) * wders(i, 0) * ders[(k-i)*m+l];
 
                 glm::vec3 v1(0.0f);
                 for (int j = 1; j <= l; ++j)
                 {
-                    v1 -= (float)Binomial(j, l) * wders[i][j] * ders[k - 1][l - j];
+                    v1 += (float)Binomial(j, l) * wders(i, j) * ders[(k-i)*m+l-j];
                 }
 
                 v0 -= (float)Binomial(i, k) * v1;
             }
 
-            v0 *= 1 / wders[0][0];
-            ders[k][l] = v0;
+            v0 *= 1 / wders(0, 0);
+            ders[k*m+l] = v0;
         }
     }
+}
+
+inline std::vector<std::vector<glm::vec3>> SurfaceDerivatives(const tinynurbs::RationalSurface<float>& srf, const size_t num_ders, const float u, const float v)
+{
+    EvaluationContext context;
+    std::vector<glm::vec3> flat((num_ders + 1) * (num_ders + 1));
+    SurfaceDerivatives(context, srf, num_ders, u, v, flat);
+
+    std::vector ders(num_ders + 1, std::vector(num_ders + 1, glm::vec3(0.0f)));
+
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        std::copy_n(flat.begin() + (long long)(k * (num_ders + 1)), num_ders + 1, ders[k].begin());
+    }
 
     return ders;
 }
 
-inline glm::vec3 SurfaceNormal(const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
+inline glm::vec3 SurfaceNormal(EvaluationContext& context, const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
 {
-    const auto surface_derivatives = SurfaceDerivatives(srf, 1, u, v);
-    const auto n = glm::cross(surface_derivatives[0][1], surface_derivatives[1][0]);
+    std::array<glm::vec3, 4> surface_derivatives;
+    SurfaceDerivatives(context, srf, 1, u, v, surface_derivatives);
+    const auto n = glm::cross(surface_derivatives[1], surface_derivatives[2]);
     if (glm::length(n) <= std::numeric_limits<float>::epsilon())
     {
         return glm::vec3(0.0f);
@@ -406,6 +501,12 @@ inline glm::vec3 SurfaceNormal(const tinynurbs::RationalSurface<float>& srf, con
     return glm::normalize(n);
 }
 
+inline glm::vec3 SurfaceNormal(const tinynurbs::RationalSurface<float>& srf, const float u, const float v)
+{
+    EvaluationContext context;
+    return SurfaceNormal(context, srf, u, v);
+}
+
 }
 
 #endif //NURBS_H
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file           : Parallel.h
+  * @author         : AliceRemake
+  * @brief          : Thread Helpers
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <bits/stdc++.h>
+
+namespace NURBS
+{
+
+/// @brief Call function(i) For Every i In [begin, end) On Up To num_threads Threads (0 Means All Cores).
+///
+/// Indices Are Handed Out In Chunks Of grain From A Shared Counter, So Uneven Work Balances Itself. The Calling
+/// Thread Works Too. The First Exception Thrown By function Is Rethrown After All Threads Finish.
+///
+template <typename Function>
+void ParallelFor(const size_t begin, const size_t end, const Function& function, size_t num_threads = 0, const size_t grain = 1)
+{
+    assert(grain > 0);
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    if (num_threads == 0)
+    {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::min(num_threads, (end - begin + grain - 1) / grain);
+
+    std::atomic<size_t> next = begin;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    const auto work = [&]
+    {
+        try
+        {
+            for (size_t first = next.fetch_add(grain); first < end; first = next.fetch_add(grain))
+            {
+                for (size_t i = first; i < std::min(first + grain, end); ++i)
+                {
+                    function(i);
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(exception_mutex);
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+            next = end;
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_threads - 1);
+        for (size_t i = 1; i < num_threads; ++i)
+        {
+            threads.emplace_back(work);
+        }
+        work();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+}
+
+#endif //PARALLEL_H
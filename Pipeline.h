@@ -0,0 +1,644 @@
+/**
+  ******************************************************************************
+  * @file           : Pipeline.h
+  * @author         : AliceRemake
+  * @brief          : Coroutine Pipeline From Loading Surfaces To Writing Meshes
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Tessellation.h>
+#include <Mesh.h>
+
+namespace NURBS
+{
+
+/// @brief Threads Resuming Coroutines In FIFO Order.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t num_threads = 0)
+    {
+        if (num_threads == 0)
+        {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            workers_.emplace_back([this](const std::stop_token stop_token) { Work(stop_token); });
+        }
+    }
+
+    void Post(const std::coroutine_handle<> handle)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            handles_.push_back(handle);
+        }
+        condition_.notify_one();
+    }
+
+    /// @brief co_await pool.Schedule() Continues The Coroutine On A Worker.
+    auto Schedule() noexcept
+    {
+        struct Awaiter
+        {
+            ThreadPool& pool;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(const std::coroutine_handle<> handle) const
+            {
+                pool.Post(handle);
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+        return Awaiter{ *this };
+    }
+
+private:
+    void Work(const std::stop_token stop_token)
+    {
+        while (true)
+        {
+            std::unique_lock lock(mutex_);
+            if (!condition_.wait(lock, stop_token, [this] { return !handles_.empty(); }))
+            {
+                return;
+            }
+            const auto handle = handles_.front();
+            handles_.pop_front();
+            lock.unlock();
+
+            handle.resume();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable_any condition_;
+    std::deque<std::coroutine_handle<>> handles_;
+    // Destroyed First: Each jthread Requests Stop And Joins, Waking Work Out Of condition_ While mutex_, condition_
+    // And handles_ Are Still Alive. Handles Still Queued Then Are Dropped, Not Resumed.
+    std::vector<std::jthread> workers_;
+};
+
+/// @brief Bounded FIFO Between Coroutines.
+///
+/// co_await Push(value) Suspends While The Channel Is Full (Back-Pressure) And Yields false Once It Is Closed; value Is
+/// Moved From When Accepted. co_await Pop(value) Suspends While It Is Empty And Yields false Once It Is Closed And
+/// Drained. Suspended Coroutines Are Resumed On The Pool, Never Inside The Call That Woke Them.
+///
+/// The Awaiters Only Hold Pointers To Named Values Of The Caller: Temporaries With Destructors Inside co_await
+/// Operands Are Miscompiled By Some Compilers.
+///
+template <typename T>
+class Channel
+{
+public:
+    Channel(ThreadPool& pool, const size_t capacity)
+        : pool_(pool), capacity_(capacity)
+    {}
+
+    struct PushAwaiter
+    {
+        Channel* channel;
+        T* value;
+        bool pushed = false;
+        std::coroutine_handle<> handle = nullptr;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(const std::coroutine_handle<> h)
+        {
+            std::lock_guard lock(channel->mutex_);
+            if (channel->closed_)
+            {
+                return false;
+            }
+            pushed = true;
+            if (!channel->poppers_.empty())
+            {
+                PopAwaiter* popper = channel->poppers_.front();
+                channel->poppers_.pop_front();
+                *popper->value = std::move(*value);
+                popper->popped = true;
+                channel->pool_.Post(popper->handle);
+                return false;
+            }
+            if (channel->items_.size() < channel->capacity_)
+            {
+                channel->items_.push_back(std::move(*value));
+                return false;
+            }
+            pushed = false;
+            handle = h;
+            channel->pushers_.push_back(this);
+            return true;
+        }
+
+        bool await_resume() const noexcept
+        {
+            return pushed;
+        }
+    };
+
+    struct PopAwaiter
+    {
+        Channel* channel;
+        T* value;
+        bool popped = false;
+        std::coroutine_handle<> handle = nullptr;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(const std::coroutine_handle<> h)
+        {
+            std::lock_guard lock(channel->mutex_);
+            if (!channel->items_.empty())
+            {
+                *value = std::move(channel->items_.front());
+                channel->items_.pop_front();
+                popped = true;
+                if (!channel->pushers_.empty())
+                {
+                    PushAwaiter* pusher = channel->pushers_.front();
+                    channel->pushers_.pop_front();
+                    channel->items_.push_back(std::move(*pusher->value));
+                    pusher->pushed = true;
+                    channel->pool_.Post(pusher->handle);
+                }
+                return false;
+            }
+            if (!channel->pushers_.empty())
+            {
+                PushAwaiter* pusher = channel->pushers_.front();
+                channel->pushers_.pop_front();
+                *value = std::move(*pusher->value);
+                popped = true;
+                pusher->pushed = true;
+                channel->pool_.Post(pusher->handle);
+                return false;
+            }
+            if (channel->closed_)
+            {
+                return false;
+            }
+            handle = h;
+            channel->poppers_.push_back(this);
+            return true;
+        }
+
+        bool await_resume() const noexcept
+        {
+            return popped;
+        }
+    };
+
+    [[nodiscard]] PushAwaiter Push(T& value) noexcept
+    {
+        return PushAwaiter{ this, &value };
+    }
+
+    [[nodiscard]] PopAwaiter Pop(T& value) noexcept
+    {
+        return PopAwaiter{ this, &value };
+    }
+
+    /// @brief Wake Every Waiting Coroutine. Items Already Queued Can Still Be Popped.
+    void Close()
+    {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        for (PopAwaiter* popper : poppers_)
+        {
+            pool_.Post(popper->handle);
+        }
+        for (PushAwaiter* pusher : pushers_)
+        {
+            pool_.Post(pusher->handle);
+        }
+        poppers_.clear();
+        pushers_.clear();
+    }
+
+private:
+    ThreadPool& pool_;
+    size_t capacity_;
+    std::mutex mutex_;
+    std::deque<T> items_;
+    std::deque<PushAwaiter*> pushers_;
+    std::deque<PopAwaiter*> poppers_;
+    bool closed_ = false;
+};
+
+/// @brief Fire And Forget Coroutine. It Starts Inline And Frees Itself When Done, So Its Body Must Catch Everything.
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+struct PipelineOptions
+{
+    /// @brief Pool Threads, 0 Means All Cores.
+    size_t num_threads = 0;
+    /// @brief Tile Evaluation Coroutines, 0 Means One Per Pool Thread.
+    size_t num_evaluators = 0;
+    /// @brief Capacity Of Every Queue Between Stages.
+    size_t queue_capacity = 16;
+    /// @brief Samples Per Knot Span Tile Side.
+    size_t resolution = 8;
+    float weld_tolerance = 0.0f;
+    /// @brief Vertices Per Mesh Chunk Handed To write.
+    size_t chunk_size = 16384;
+};
+
+struct PipelineStatistics
+{
+    size_t num_surfaces = 0;
+    size_t num_tiles = 0;
+    size_t num_chunks = 0;
+    size_t num_vertices = 0;
+    size_t num_triangles = 0;
+    /// @brief From Start Until The First Chunk Was Written.
+    double first_chunk_seconds = 0.0;
+    double total_seconds = 0.0;
+};
+
+namespace internal
+{
+
+/// @brief Work Item Of The Evaluation Stage.
+struct TileJob
+{
+    std::shared_ptr<const tinynurbs::RationalSurface<float>> surface;
+    size_t mesh_surface = 0;
+    size_t u_span = 0;
+    size_t v_span = 0;
+};
+
+struct EvaluatedTile
+{
+    size_t mesh_surface = 0;
+    SurfaceTile tile;
+};
+
+/// @brief Shared By All Stages Of One Run: Live Stage Count, First Error, And Every Channel To Close On Error.
+///
+/// Every Stage Coroutine Holds A Stage Token As The First Local Of Its Body, So The Token Is Destroyed After Everything
+/// Else In The Frame And Only Freeing The Frame Follows, Which Touches Nothing Of RunPipeline. Wait Returns Once No
+/// Token Is Alive, So RunPipeline Cannot Destroy The Channels, Builder Or Stage Lambdas Under A Running Stage; The
+/// Destructor Asserts It. The Pool Outlives The State, And Its Workers Are Joined After The Frames Are Freed.
+class PipelineState
+{
+public:
+    class Stage
+    {
+    public:
+        explicit Stage(PipelineState& state)
+            : state_(state)
+        {
+            std::lock_guard lock(state_.mutex_);
+            ++state_.live_;
+        }
+
+        Stage(const Stage&) = delete;
+        Stage& operator=(const Stage&) = delete;
+
+        ~Stage()
+        {
+            // Notify Under The Lock, Wait Cannot Return And Destroy The State Before notify_all Is Done.
+            std::lock_guard lock(state_.mutex_);
+            if (--state_.live_ == 0)
+            {
+                state_.condition_.notify_all();
+            }
+        }
+
+    private:
+        PipelineState& state_;
+    };
+
+    PipelineState() = default;
+
+    PipelineState(const PipelineState&) = delete;
+    PipelineState& operator=(const PipelineState&) = delete;
+
+    ~PipelineState()
+    {
+        assert(live_ == 0);
+    }
+
+    /// @brief Token For A Stage Started Synchronously By The Caller Of Wait, Before Wait Is Called.
+    [[nodiscard]] Stage Enter()
+    {
+        return Stage(*this);
+    }
+
+    /// @brief Block Until Every Stage Has Dropped Its Token.
+    void Wait()
+    {
+        std::unique_lock lock(mutex_);
+        condition_.wait(lock, [this] { return live_ == 0; });
+    }
+
+    void Fail(const std::exception_ptr exception)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            if (!exception_)
+            {
+                exception_ = exception;
+            }
+        }
+        failed_ = true;
+        close_all();
+    }
+
+    [[nodiscard]] bool Failed() const noexcept
+    {
+        return failed_;
+    }
+
+    void Rethrow() const
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+    std::function<void()> close_all;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    size_t live_ = 0;
+    std::exception_ptr exception_;
+    std::atomic<bool> failed_ = false;
+};
+
+}
+
+/// @brief Tessellate Every Surface load Returns Into One Mesh Handed To write In Chunks, All Stages Running At Once.
+///
+/// Stages Are Coroutines On A Shared Pool, Connected By Bounded Channels:
+/// load (Calls load Until It Returns Nothing) -> prepare (Registers The Control Net With The MeshBuilder And Splits It
+/// Into Knot Span Tiles) -> evaluate (num_evaluators Coroutines Running TessellateTile) -> build (MeshBuilder) ->
+/// write (Calls write In Order). A Full Channel Suspends Its Producer, So A Slow Writer Throttles Loading And Memory
+/// Stays Bounded By The Queue Capacities. load And write Run On Pool Threads, One Call At A Time.
+///
+/// The First Exception Of Any Stage Stops The Pipeline And Is Rethrown.
+///
+inline PipelineStatistics RunPipeline(const std::function<std::optional<tinynurbs::RationalSurface<float>>()>& load,
+                                      const std::function<void(const MeshChunk&)>& write,
+                                      const PipelineOptions& options = {})
+{
+    using Surface = std::shared_ptr<const tinynurbs::RationalSurface<float>>;
+    using Clock = std::chrono::steady_clock;
+
+    const auto start = Clock::now();
+    PipelineStatistics statistics;
+
+    ThreadPool pool(options.num_threads);
+    const size_t num_evaluators = options.num_evaluators > 0 ? options.num_evaluators
+                                                             : options.num_threads > 0 ? options.num_threads : std::max(1u, std::thread::hardware_concurrency());
+
+    Channel<Surface> loaded(pool, options.queue_capacity);
+    Channel<internal::TileJob> jobs(pool, options.queue_capacity);
+    Channel<internal::EvaluatedTile> evaluated(pool, options.queue_capacity);
+    Channel<MeshChunk> chunks(pool, options.queue_capacity);
+
+    internal::PipelineState state;
+    state.close_all = [&]
+    {
+        loaded.Close();
+        jobs.Close();
+        evaluated.Close();
+        chunks.Close();
+    };
+
+    // Chunks Of The Builder Are Collected Here, Then Pushed By The Build Stage.
+    std::vector<MeshChunk> built;
+    MeshBuilder builder([&built](const MeshChunk& chunk) { built.push_back(chunk); }, options.weld_tolerance, options.chunk_size);
+
+    const auto load_stage = [&]() -> DetachedTask
+    {
+        const auto stage = state.Enter();
+        co_await pool.Schedule();
+        try
+        {
+            while (!state.Failed())
+            {
+                auto srf = load();
+                if (!srf)
+                {
+                    break;
+                }
+                ++statistics.num_surfaces;
+                Surface surface = std::make_shared<const tinynurbs::RationalSurface<float>>(std::move(*srf));
+                if (!co_await loaded.Push(surface))
+                {
+                    break;
+                }
+            }
+            loaded.Close();
+        }
+        catch (...)
+        {
+            state.Fail(std::current_exception());
+        }
+    };
+
+    const auto prepare_stage = [&]() -> DetachedTask
+    {
+        const auto stage = state.Enter();
+        co_await pool.Schedule();
+        try
+        {
+            Surface surface;
+            bool pushed = true;
+            while (pushed && co_await loaded.Pop(surface))
+            {
+                assert(surface->knots_u.size() == surface->control_points.rows() + surface->degree_u + 1);
+                assert(surface->knots_v.size() == surface->control_points.cols() + surface->degree_v + 1);
+
+                const size_t mesh_surface = builder.AddSurface(*surface, options.resolution);
+                const auto u_spans = KnotSpans(surface->degree_u, surface->knots_u);
+                const auto v_spans = KnotSpans(surface->degree_v, surface->knots_v);
+                for (size_t a = 0; pushed && a < u_spans.size(); ++a)
+                {
+                    for (size_t b = 0; pushed && b < v_spans.size(); ++b)
+                    {
+                        ++statistics.num_tiles;
+                        internal::TileJob job{ surface, mesh_surface, u_spans[a], v_spans[b] };
+                        pushed = co_await jobs.Push(job);
+                    }
+                }
+            }
+            jobs.Close();
+        }
+        catch (...)
+        {
+            state.Fail(std::current_exception());
+        }
+    };
+
+    std::atomic<size_t> running_evaluators = num_evaluators;
+    const auto evaluate_stage = [&]() -> DetachedTask
+    {
+        const auto stage = state.Enter();
+        co_await pool.Schedule();
+        try
+        {
+            internal::TileJob job;
+            internal::EvaluatedTile evaluated_tile;
+            while (co_await jobs.Pop(job))
+            {
+                evaluated_tile.mesh_surface = job.mesh_surface;
+                evaluated_tile.tile.u_span = job.u_span;
+                evaluated_tile.tile.v_span = job.v_span;
+                evaluated_tile.tile.resolution = options.resolution;
+                TessellateTile(*job.surface, evaluated_tile.tile);
+                job.surface.reset();
+                if (!co_await evaluated.Push(evaluated_tile))
+                {
+                    break;
+                }
+            }
+            if (--running_evaluators == 0)
+            {
+                evaluated.Close();
+            }
+        }
+        catch (...)
+        {
+            state.Fail(std::current_exception());
+        }
+    };
+
+    const auto build_stage = [&]() -> DetachedTask
+    {
+        const auto stage = state.Enter();
+        co_await pool.Schedule();
+        try
+        {
+            internal::EvaluatedTile evaluated_tile;
+            bool pushed = true;
+            while (pushed)
+            {
+                const bool popped = co_await evaluated.Pop(evaluated_tile);
+                if (popped)
+                {
+                    builder.AddTile(evaluated_tile.mesh_surface, evaluated_tile.tile);
+                }
+                else
+                {
+                    builder.Flush();
+                }
+                for (size_t i = 0; pushed && i < built.size(); ++i)
+                {
+                    pushed = co_await chunks.Push(built[i]);
+                }
+                built.clear();
+                if (!popped)
+                {
+                    break;
+                }
+            }
+            chunks.Close();
+        }
+        catch (...)
+        {
+            state.Fail(std::current_exception());
+        }
+    };
+
+    const auto write_stage = [&]() -> DetachedTask
+    {
+        const auto stage = state.Enter();
+        co_await pool.Schedule();
+        try
+        {
+            MeshChunk chunk;
+            while (!state.Failed() && co_await chunks.Pop(chunk))
+            {
+                write(chunk);
+                if (statistics.num_chunks++ == 0)
+                {
+                    statistics.first_chunk_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                }
+            }
+        }
+        catch (...)
+        {
+            state.Fail(std::current_exception());
+        }
+    };
+
+    // Consumers First, So Producers Find Them Waiting.
+    write_stage();
+    build_stage();
+    for (size_t i = 0; i < num_evaluators; ++i)
+    {
+        evaluate_stage();
+    }
+    prepare_stage();
+    load_stage();
+
+    state.Wait();
+    state.Rethrow();
+
+    statistics.num_vertices = builder.NumVertices();
+    statistics.num_triangles = builder.NumTriangles();
+    statistics.total_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return statistics;
+}
+
+}
+
+#endif //PIPELINE_H
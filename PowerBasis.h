@@ -0,0 +1,386 @@
+/**
+  ******************************************************************************
+  * @file           : PowerBasis.h
+  * @author         : AliceRemake
+  * @brief          : Per Span Power Basis Representation With Horner Evaluation
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef POWER_BASIS_H
+#define POWER_BASIS_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Bezier.h>
+
+namespace NURBS
+{
+
+/// @brief Monomial Coefficients a_k Of A Bezier Segment On t In [0, 1]:
+/// sum_i b_i B_{i,p}(t) = sum_k a_k t^k, a_k = C_p^k sum_{i<=k} (-1)^(k-i) C_k^i b_i.
+template <typename T, typename Point>
+void BezierToPower(const std::span<const Point> bezier, const std::span<Point> power)
+{
+    const size_t degree = bezier.size() - 1;
+    for (size_t k = 0; k <= degree; ++k)
+    {
+        Point coefficient = bezier[0] * T(0);
+        for (size_t i = 0; i <= k; ++i)
+        {
+            const T sign = (k - i) % 2 == 0 ? T(1) : T(-1);
+            coefficient = coefficient + bezier[i] * (sign * (T)Binomial(i, k));
+        }
+        power[k] = coefficient * (T)Binomial(k, degree);
+    }
+}
+
+/// @brief Index Of The Piece Containing u Among breakpoints, Clamped Like FindSpan So u = breakpoints.back() Falls
+/// In The Last Piece.
+template <typename T>
+size_t FindPiece(const std::vector<T>& breakpoints, const T u) noexcept
+{
+    assert(breakpoints.size() >= 2);
+    return (size_t)(std::upper_bound(breakpoints.begin() + 1, breakpoints.end() - 1, u) - breakpoints.begin() - 1);
+}
+
+/// @brief Curve Compiled To Homogeneous Polynomials, One Per Nonempty Knot Span.
+///
+/// Piece s Covers [breakpoints[s], breakpoints[s+1]] And Is sum_k coefficients[s * (degree + 1) + k] t^k With
+/// The Local Parameter t = (u - breakpoints[s]) / (breakpoints[s+1] - breakpoints[s]) In [0, 1].
+///
+template <typename T>
+struct PowerBasisCurve
+{
+    size_t degree = 0;
+    std::vector<T> breakpoints;
+    std::vector<glm::vec<4, T>> coefficients;
+};
+
+/// @brief Surface Compiled To Homogeneous Polynomials, One Per Nonempty Knot Span Tile.
+///
+/// Tile (s, r) Covers u Piece s And v Piece r (As For PowerBasisCurve) And Is sum_{k,l} c_{k,l} t_u^k t_v^l With
+/// c_{k,l} = coefficients[((s * num_v_pieces + r) * (degree_u + 1) + k) * (degree_v + 1) + l].
+///
+template <typename T>
+struct PowerBasisSurface
+{
+    size_t degree_u = 0;
+    size_t degree_v = 0;
+    std::vector<T> u_breakpoints;
+    std::vector<T> v_breakpoints;
+    std::vector<glm::vec<4, T>> coefficients;
+};
+
+/// @brief Compile crv To Power Basis In Precision T. Knots Must Be Clamped.
+template <typename T>
+PowerBasisCurve<T> ToPowerBasis(const tinynurbs::RationalCurve<float>& crv)
+{
+    using Point = glm::vec<4, T>;
+
+    const std::vector<T> knots(crv.knots.begin(), crv.knots.end());
+    std::vector<Point> homo_control_points(crv.control_points.size());
+
+    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    {
+        const T w = crv.weights[i];
+        homo_control_points[i] = Point(glm::vec<3, T>(crv.control_points[i]) * w, w);
+    }
+
+    PowerBasisCurve<T> power_basis_curve;
+    power_basis_curve.degree = crv.degree;
+    power_basis_curve.breakpoints = Breakpoints(crv.degree, knots);
+
+    const auto segments = DecomposeBezier(crv.degree, knots, homo_control_points);
+    assert(segments.size() + 1 == power_basis_curve.breakpoints.size());
+
+    power_basis_curve.coefficients.resize(segments.size() * (crv.degree + 1));
+    for (size_t s = 0; s < segments.size(); ++s)
+    {
+        BezierToPower<T, Point>(segments[s], std::span(power_basis_curve.coefficients).subspan(s * (crv.degree + 1), crv.degree + 1));
+    }
+
+    return power_basis_curve;
+}
+
+/// @brief Compile srf To Power Basis In Precision T. Knots Must Be Clamped.
+template <typename T>
+PowerBasisSurface<T> ToPowerBasis(const tinynurbs::RationalSurface<float>& srf)
+{
+    using Point = glm::vec<4, T>;
+
+    const size_t degree_u = srf.degree_u;
+    const size_t degree_v = srf.degree_v;
+    const std::vector<T> knots_u(srf.knots_u.begin(), srf.knots_u.end());
+    const std::vector<T> knots_v(srf.knots_v.begin(), srf.knots_v.end());
+
+    PowerBasisSurface<T> power_basis_surface;
+    power_basis_surface.degree_u = degree_u;
+    power_basis_surface.degree_v = degree_v;
+    power_basis_surface.u_breakpoints = Breakpoints(degree_u, knots_u);
+    power_basis_surface.v_breakpoints = Breakpoints(degree_v, knots_v);
+
+    [[maybe_unused]] const size_t num_u_pieces = power_basis_surface.u_breakpoints.size() - 1;
+    [[maybe_unused]] const size_t num_v_pieces = power_basis_surface.v_breakpoints.size() - 1;
+    const size_t size = (degree_u + 1) * (degree_v + 1);
+
+    const auto patches = DecomposeBezier<T>(srf);
+    assert(patches.size() == num_u_pieces * num_v_pieces);
+
+    power_basis_surface.coefficients.resize(patches.size() * size);
+
+    std::vector<Point> half_converted(size);
+    std::vector<Point> column(degree_u + 1);
+    std::vector<Point> line(degree_u + 1);
+
+    for (size_t patch = 0; patch < patches.size(); ++patch)
+    {
+        // Power Basis Along u For Every l, Then Along v For Every k.
+        for (size_t l = 0; l <= degree_v; ++l)
+        {
+            for (size_t k = 0; k <= degree_u; ++k)
+            {
+                column[k] = patches[patch][k * (degree_v + 1) + l];
+            }
+            BezierToPower<T, Point>(column, line);
+            for (size_t k = 0; k <= degree_u; ++k)
+            {
+                half_converted[k * (degree_v + 1) + l] = line[k];
+            }
+        }
+
+        const auto coefficients = std::span(power_basis_surface.coefficients).subspan(patch * size, size);
+        for (size_t k = 0; k <= degree_u; ++k)
+        {
+            BezierToPower<T, Point>(std::span<const Point>(half_converted).subspan(k * (degree_v + 1), degree_v + 1), coefficients.subspan(k * (degree_v + 1), degree_v + 1));
+        }
+    }
+
+    return power_basis_surface;
+}
+
+inline constexpr size_t MaxPowerBasisDerivatives = 8;
+
+/// @brief Horner's Scheme For p(t) And Its First num_ders Derivatives By t Into ders.
+template <typename T, typename Point>
+void Horner(const std::span<const Point> coefficients, const T t, const size_t num_ders, const std::span<Point> ders)
+{
+    std::fill_n(ders.begin(), num_ders + 1, coefficients[0] * T(0));
+    for (size_t i = coefficients.size(); i-- > 0;)
+    {
+        for (size_t k = std::min(num_ders, coefficients.size() - 1 - i); k >= 1; --k)
+        {
+            ders[k] = ders[k] * t + ders[k-1];
+        }
+        ders[0] = ders[0] * t + coefficients[i];
+    }
+    // Synthetic Division Leaves p^(k) / k!.
+    T factorial = 1;
+    for (size_t k = 2; k <= num_ders; ++k)
+    {
+        factorial *= (T)k;
+        ders[k] = ders[k] * factorial;
+    }
+}
+
+template <typename T>
+glm::vec<3, T> CurvePoint(const PowerBasisCurve<T>& crv, const T u)
+{
+    const size_t piece = FindPiece(crv.breakpoints, u);
+    const T t = (u - crv.breakpoints[piece]) / (crv.breakpoints[piece+1] - crv.breakpoints[piece]);
+    const glm::vec<4, T>* coefficients = crv.coefficients.data() + piece * (crv.degree + 1);
+
+    glm::vec<4, T> point = coefficients[crv.degree];
+    for (size_t k = crv.degree; k-- > 0;)
+    {
+        point = point * t + coefficients[k];
+    }
+
+    return glm::vec<3, T>(point) / point.w;
+}
+
+/// @brief Same Quotient Rule As CurveDerivatives, num_ders Is At Most MaxPowerBasisDerivatives.
+template <typename T>
+std::vector<glm::vec<3, T>> CurveDerivatives(const PowerBasisCurve<T>& crv, const size_t num_ders, const T u)
+{
+    assert(num_ders <= MaxPowerBasisDerivatives);
+
+    const size_t piece = FindPiece(crv.breakpoints, u);
+    const T h = crv.breakpoints[piece+1] - crv.breakpoints[piece];
+    const T t = (u - crv.breakpoints[piece]) / h;
+
+    std::array<glm::vec<4, T>, MaxPowerBasisDerivatives + 1> homo_curve_derivative;
+    Horner<T, glm::vec<4, T>>(std::span(crv.coefficients).subspan(piece * (crv.degree + 1), crv.degree + 1), t, num_ders, homo_curve_derivative);
+
+    // d/du = 1/h d/dt.
+    T scale = 1;
+    for (size_t k = 1; k <= num_ders; ++k)
+    {
+        scale /= h;
+        homo_curve_derivative[k] = homo_curve_derivative[k] * scale;
+    }
+
+    std::vector<glm::vec<3, T>> ders(num_ders + 1);
+
+    for (size_t d = 0; d <= num_ders; ++d)
+    {
+        ders[d] = glm::vec<3, T>(homo_curve_derivative[d]);
+        for (size_t i = 1; i <= d; ++i)
+        {
+            ders[d] -= (T)Binomial(i, d) * homo_curve_derivative[i].w * ders[d-i];
+        }
+        ders[d] /= homo_curve_derivative[0].w;
+    }
+
+    return ders;
+}
+
+template <typename T>
+glm::vec<3, T> SurfacePoint(const PowerBasisSurface<T>& srf, const T u, const T v)
+{
+    const size_t s = FindPiece(srf.u_breakpoints, u);
+    const size_t r = FindPiece(srf.v_breakpoints, v);
+    const T tu = (u - srf.u_breakpoints[s]) / (srf.u_breakpoints[s+1] - srf.u_breakpoints[s]);
+    const T tv = (v - srf.v_breakpoints[r]) / (srf.v_breakpoints[r+1] - srf.v_breakpoints[r]);
+    const glm::vec<4, T>* coefficients = srf.coefficients.data() + (s * (srf.v_breakpoints.size() - 1) + r) * (srf.degree_u + 1) * (srf.degree_v + 1);
+
+    glm::vec<4, T> point(T(0));
+    for (size_t k = srf.degree_u + 1; k-- > 0;)
+    {
+        const glm::vec<4, T>* row = coefficients + k * (srf.degree_v + 1);
+        glm::vec<4, T> tmp = row[srf.degree_v];
+        for (size_t l = srf.degree_v; l-- > 0;)
+        {
+            tmp = tmp * tv + row[l];
+        }
+        point = point * tu + tmp;
+    }
+
+    return glm::vec<3, T>(point) / point.w;
+}
+
+/// @brief Same Quotient Rule As SurfaceDerivatives, ders[k][l] = d^(k+l) S / du^k dv^l For k + l <= num_ders, num_ders
+/// Is At Most MaxPowerBasisDerivatives.
+template <typename T>
+std::vector<std::vector<glm::vec<3, T>>> SurfaceDerivatives(const PowerBasisSurface<T>& srf, const size_t num_ders, const T u, const T v)
+{
+    using Point = glm::vec<4, T>;
+
+    assert(num_ders <= MaxPowerBasisDerivatives);
+
+    const size_t s = FindPiece(srf.u_breakpoints, u);
+    const size_t r = FindPiece(srf.v_breakpoints, v);
+    const T hu = srf.u_breakpoints[s+1] - srf.u_breakpoints[s];
+    const T hv = srf.v_breakpoints[r+1] - srf.v_breakpoints[r];
+    const T tu = (u - srf.u_breakpoints[s]) / hu;
+    const T tv = (v - srf.v_breakpoints[r]) / hv;
+    const size_t nu = srf.degree_u + 1;
+    const size_t nv = srf.degree_v + 1;
+    const Point* coefficients = srf.coefficients.data() + (s * (srf.v_breakpoints.size() - 1) + r) * nu * nv;
+
+    // Horner Along v In Every Row, Then Along u Over Each Derivative By v. v_ders[l * nu + k] Is Row k Differentiated l Times.
+    std::array<Point, MaxPowerBasisDerivatives + 1> horner;
+    std::vector<Point> v_ders((num_ders + 1) * nu);
+    for (size_t k = 0; k < nu; ++k)
+    {
+        Horner<T, Point>(std::span<const Point>(coefficients + k * nv, nv), tv, num_ders, horner);
+        for (size_t l = 0; l <= num_ders; ++l)
+        {
+            v_ders[l * nu + k] = horner[l];
+        }
+    }
+
+    // d/du = 1/hu d/dt_u, d/dv = 1/hv d/dt_v.
+    std::vector homo_surface_derivatives(num_ders + 1, std::vector(num_ders + 1, Point(T(0))));
+    T v_scale = 1;
+    for (size_t l = 0; l <= num_ders; ++l)
+    {
+        Horner<T, Point>(std::span<const Point>(v_ders).subspan(l * nu, nu), tu, num_ders - l, horner);
+        T scale = v_scale;
+        for (size_t k = 0; k + l <= num_ders; ++k)
+        {
+            homo_surface_derivatives[k][l] = horner[k] * scale;
+            scale /= hu;
+        }
+        v_scale /= hv;
+    }
+
+    const auto wders = [&](const size_t k, const size_t l) { return homo_surface_derivatives[k][l].w; };
+    std::vector ders(num_ders + 1, std::vector(num_ders + 1, glm::vec<3, T>(T(0))));
+
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        for (size_t l = 0; k + l <= num_ders; ++l)
+        {
+            glm::vec<3, T> v0(homo_surface_derivatives[k][l]);
+
+            for (size_t j = 1; j <= l; ++j)
+            {
+                v0 -= (T)Binomial(j, l) * wders(0, j) * ders[k][l-j];
+            }
+
+            for (size_t i = 1; i <= k; ++i)
+            {
+                v0 -= (T)Binomial(i, k) * wders(i, 0) * ders[k-i][l];
+
+                glm::vec<3, T> v1(T(0));
+                for (size_t j = 1; j <= l; ++j)
+                {
+                    v1 += (T)Binomial(j, l) * wders(i, j) * ders[k-i][l-j];
+                }
+
+                v0 -= (T)Binomial(i, k) * v1;
+            }
+
+            ders[k][l] = v0 / wders(0, 0);
+        }
+    }
+
+    return ders;
+}
+
+/// @brief Same Convention As SurfaceNormal: normalize(cross(S_v, S_u)), Zero When Degenerate.
+template <typename T>
+glm::vec<3, T> SurfaceNormal(const PowerBasisSurface<T>& srf, const T u, const T v)
+{
+    const size_t s = FindPiece(srf.u_breakpoints, u);
+    const size_t r = FindPiece(srf.v_breakpoints, v);
+    const T hu = srf.u_breakpoints[s+1] - srf.u_breakpoints[s];
+    const T hv = srf.v_breakpoints[r+1] - srf.v_breakpoints[r];
+    const T tu = (u - srf.u_breakpoints[s]) / hu;
+    const T tv = (v - srf.v_breakpoints[r]) / hv;
+    const glm::vec<4, T>* coefficients = srf.coefficients.data() + (s * (srf.v_breakpoints.size() - 1) + r) * (srf.degree_u + 1) * (srf.degree_v + 1);
+
+    glm::vec<4, T> A(T(0)), Au(T(0)), Av(T(0));
+    for (size_t k = srf.degree_u + 1; k-- > 0;)
+    {
+        const glm::vec<4, T>* row = coefficients + k * (srf.degree_v + 1);
+        glm::vec<4, T> tmp = row[srf.degree_v], tmp_v(T(0));
+        for (size_t l = srf.degree_v; l-- > 0;)
+        {
+            tmp_v = tmp_v * tv + tmp;
+            tmp = tmp * tv + row[l];
+        }
+        Au = Au * tu + A;
+        A = A * tu + tmp;
+        Av = Av * tu + tmp_v;
+    }
+
+    const glm::vec<3, T> point = glm::vec<3, T>(A) / A.w;
+    const glm::vec<3, T> Su = (glm::vec<3, T>(Au) - Au.w * point) / (A.w * hu);
+    const glm::vec<3, T> Sv = (glm::vec<3, T>(Av) - Av.w * point) / (A.w * hv);
+    const glm::vec<3, T> n = glm::cross(Sv, Su);
+    if (glm::length(n) <= std::numeric_limits<T>::epsilon())
+    {
+        return glm::vec<3, T>(T(0));
+    }
+    return glm::normalize(n);
+}
+
+}
+
+#endif //POWER_BASIS_H
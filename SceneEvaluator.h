@@ -0,0 +1,305 @@
+/**
+  ******************************************************************************
+  * @file           : SceneEvaluator.h
+  * @author         : AliceRemake
+  * @brief          : Batch Evaluation Of Many Small Curves
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef SCENE_EVALUATOR_H
+#define SCENE_EVALUATOR_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Parallel.h>
+
+namespace NURBS
+{
+
+/// @brief Curves Of One Degree Packed Into Flat Buffers.
+struct CurveGroup
+{
+    struct Record
+    {
+        size_t knot_offset = 0;
+        size_t control_point_offset = 0;
+        size_t num_control_points = 0;
+        size_t num_samples = 0;
+        size_t output_offset = 0;
+    };
+
+    size_t degree = 0;
+    std::vector<float> knots;
+    std::vector<glm::vec4> homo_control_points;
+    std::vector<Record> records;
+};
+
+/// @brief Sample num_samples Uniform Parameters Over The Domain [u_degree, u_n+1] Of Each Curve In
+/// [first, last) Of group, Writing Point j Of A Curve To points[output_offset + j].
+///
+/// Samples Are Processed Lanes At A Time In Structure Of Arrays Form: Spans Are Found By Walking Forward (Samples Are
+/// Sorted), Then The Cox-de Boor Recursion Of BSplineBasis Runs Across Lanes With Compile Time Bounds, Which The
+/// Compiler Unrolls And Vectorizes.
+///
+template <size_t Degree>
+void EvaluateCurveGroup(const CurveGroup& group, const size_t first, const size_t last, glm::vec3* points)
+{
+    constexpr size_t Lanes = 8;
+
+    for (size_t r = first; r < last; ++r)
+    {
+        const CurveGroup::Record& record = group.records[r];
+        const float* knots = group.knots.data() + record.knot_offset;
+        const glm::vec4* homo_control_points = group.homo_control_points.data() + record.control_point_offset;
+        const float u_min = knots[Degree];
+        const float u_max = knots[record.num_control_points];
+        const float step = record.num_samples > 1 ? (u_max - u_min) / (float)(record.num_samples - 1) : 0.0f;
+
+        size_t span = Degree;
+
+        for (size_t base = 0; base < record.num_samples; base += Lanes)
+        {
+            std::array<size_t, Lanes> spans;
+            std::array<std::array<float, Lanes>, Degree + 1> b_spline_basis, left, right;
+
+            for (size_t l = 0; l < Lanes; ++l)
+            {
+                // Pad The Last Block By Repeating The Last Sample.
+                const size_t j = std::min(base + l, record.num_samples - 1);
+                const float u = j + 1 == record.num_samples ? u_max : u_min + (float)j * step;
+
+                while (span + 1 < record.num_control_points && knots[span+1] <= u)
+                {
+                    ++span;
+                }
+                spans[l] = span;
+
+                for (size_t d = 1; d <= Degree; ++d)
+                {
+                    left[d][l] = u - knots[span+1-d];
+                    right[d][l] = knots[span+d] - u;
+                }
+                b_spline_basis[0][l] = 1.0f;
+            }
+
+            for (size_t d = 1; d <= Degree; ++d)
+            {
+                std::array<float, Lanes> first_term{};
+
+                for (size_t i = 0; i < d; ++i)
+                {
+                    for (size_t l = 0; l < Lanes; ++l)
+                    {
+                        const float reused_term = b_spline_basis[i][l] / (left[d-i][l] + right[i+1][l]);
+                        b_spline_basis[i][l] = first_term[l] + right[i+1][l] * reused_term;
+                        first_term[l] = left[d-i][l] * reused_term;
+                    }
+                }
+
+                b_spline_basis[d] = first_term;
+            }
+
+            for (size_t l = 0; l < std::min(Lanes, record.num_samples - base); ++l)
+            {
+                glm::vec4 point(0.0f);
+                for (size_t i = 0; i <= Degree; ++i)
+                {
+                    point += b_spline_basis[i][l] * homo_control_points[spans[l]-Degree+i];
+                }
+                points[record.output_offset + base + l] = glm::vec3(point) / point.w;
+            }
+        }
+    }
+}
+
+/// @brief Fallback Of EvaluateCurveGroup For Degrees Without A Specialization.
+inline void EvaluateCurveGroup(const CurveGroup& group, const size_t first, const size_t last, glm::vec3* points)
+{
+    EvaluationContext context;
+    std::vector<float> b_spline_basis(group.degree + 1);
+
+    for (size_t r = first; r < last; ++r)
+    {
+        const CurveGroup::Record& record = group.records[r];
+        const std::span<const float> knots(group.knots.data() + record.knot_offset, record.num_control_points + group.degree + 1);
+        const glm::vec4* homo_control_points = group.homo_control_points.data() + record.control_point_offset;
+        const float u_min = knots[group.degree];
+        const float u_max = knots[record.num_control_points];
+        const float step = record.num_samples > 1 ? (u_max - u_min) / (float)(record.num_samples - 1) : 0.0f;
+
+        size_t span = group.degree;
+
+        for (size_t j = 0; j < record.num_samples; ++j)
+        {
+            const float u = j + 1 == record.num_samples ? u_max : u_min + (float)j * step;
+
+            while (span + 1 < record.num_control_points && knots[span+1] <= u)
+            {
+                ++span;
+            }
+
+            BSplineBasis(context, group.degree, span, knots, u, b_spline_basis);
+
+            glm::vec4 point(0.0f);
+            for (size_t i = 0; i <= group.degree; ++i)
+            {
+                point += b_spline_basis[i] * homo_control_points[span-group.degree+i];
+            }
+            points[record.output_offset + j] = glm::vec3(point) / point.w;
+        }
+    }
+}
+
+/// @brief Evaluates Many Small Curves At Once.
+///
+/// Curves Are Packed Into One CurveGroup Per Degree. Evaluate Splits Every Group Into Blocks Of Curves, Runs The
+/// Degree Specialized EvaluateCurveGroup On All Cores And Writes One Contiguous Array, Where The Samples Of Curve i
+/// Occupy [Offset(i), Offset(i) + Count(i)) In The Order Curves Were Added.
+///
+class SceneEvaluator
+{
+public:
+    /// @brief Degrees Up To This Use A Specialized Kernel.
+    static constexpr size_t MaxSpecializedDegree = 7;
+
+    /// @brief Pack crv, To Be Sampled num_samples Times Uniformly Over Its Domain.
+    /// @return Index Of The Curve.
+    size_t Add(const tinynurbs::RationalCurve<float>& crv, const size_t num_samples)
+    {
+        assert(crv.knots.size() == crv.control_points.size() + crv.degree + 1);
+        assert(crv.weights.size() == crv.control_points.size());
+        assert(num_samples > 0);
+
+        if (crv.degree >= group_of_degree_.size())
+        {
+            group_of_degree_.resize(crv.degree + 1, std::numeric_limits<size_t>::max());
+        }
+        if (group_of_degree_[crv.degree] == std::numeric_limits<size_t>::max())
+        {
+            group_of_degree_[crv.degree] = groups_.size();
+            groups_.emplace_back().degree = crv.degree;
+        }
+
+        CurveGroup& group = groups_[group_of_degree_[crv.degree]];
+        CurveGroup::Record& record = group.records.emplace_back();
+        record.knot_offset = group.knots.size();
+        record.control_point_offset = group.homo_control_points.size();
+        record.num_control_points = crv.control_points.size();
+        record.num_samples = num_samples;
+        record.output_offset = offsets_.back();
+
+        group.knots.insert(group.knots.end(), crv.knots.begin(), crv.knots.end());
+        for (size_t i = 0; i < crv.control_points.size(); ++i)
+        {
+            group.homo_control_points.emplace_back(crv.control_points[i] * crv.weights[i], crv.weights[i]);
+        }
+
+        offsets_.push_back(offsets_.back() + num_samples);
+        return offsets_.size() - 2;
+    }
+
+    void Reserve(const size_t num_curves)
+    {
+        offsets_.reserve(num_curves + 1);
+    }
+
+    void Clear()
+    {
+        groups_.clear();
+        group_of_degree_.clear();
+        offsets_.assign(1, 0);
+    }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return offsets_.size() - 1;
+    }
+
+    [[nodiscard]] size_t Offset(const size_t curve) const noexcept
+    {
+        return offsets_[curve];
+    }
+
+    [[nodiscard]] size_t Count(const size_t curve) const noexcept
+    {
+        return offsets_[curve+1] - offsets_[curve];
+    }
+
+    /// @brief Total Number Of Samples Of All Curves.
+    [[nodiscard]] size_t NumSamples() const noexcept
+    {
+        return offsets_.back();
+    }
+
+    [[nodiscard]] const std::vector<CurveGroup>& Groups() const noexcept
+    {
+        return groups_;
+    }
+
+    /// @brief Evaluate Every Curve Into points, Which Must Hold NumSamples() Points.
+    void Evaluate(const std::span<glm::vec3> points, const size_t num_threads = 0, const size_t block_size = 256) const
+    {
+        assert(points.size() >= NumSamples());
+        assert(block_size > 0);
+
+        struct Block
+        {
+            size_t group;
+            size_t first;
+            size_t last;
+        };
+
+        std::vector<Block> blocks;
+        for (size_t g = 0; g < groups_.size(); ++g)
+        {
+            for (size_t first = 0; first < groups_[g].records.size(); first += block_size)
+            {
+                blocks.push_back({ g, first, std::min(first + block_size, groups_[g].records.size()) });
+            }
+        }
+
+        ParallelFor(0, blocks.size(), [&](const size_t b)
+        {
+            const Block& block = blocks[b];
+            const CurveGroup& group = groups_[block.group];
+            Kernel(group.degree)(group, block.first, block.last, points.data());
+        }, num_threads);
+    }
+
+    [[nodiscard]] std::vector<glm::vec3> Evaluate(const size_t num_threads = 0) const
+    {
+        std::vector<glm::vec3> points(NumSamples());
+        Evaluate(points, num_threads);
+        return points;
+    }
+
+private:
+    using KernelFunction = void (*)(const CurveGroup&, size_t, size_t, glm::vec3*);
+
+    static KernelFunction Kernel(const size_t degree) noexcept
+    {
+        static constexpr auto kernels = []<size_t... Degree>(std::index_sequence<Degree...>)
+        {
+            return std::array<KernelFunction, sizeof...(Degree)>{ &EvaluateCurveGroup<Degree>... };
+        }(std::make_index_sequence<MaxSpecializedDegree + 1>());
+
+        if (degree < kernels.size())
+        {
+            return kernels[degree];
+        }
+        return static_cast<KernelFunction>(&EvaluateCurveGroup);
+    }
+
+    std::vector<CurveGroup> groups_;
+    std::vector<size_t> group_of_degree_;
+    std::vector<size_t> offsets_ = { 0 };
+};
+
+}
+
+#endif //SCENE_EVALUATOR_H
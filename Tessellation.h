@@ -0,0 +1,161 @@
+/**
+  ******************************************************************************
+  * @file           : Tessellation.h
+  * @author         : AliceRemake
+  * @brief          : Knot Span Tile Tessellation
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef TESSELLATION_H
+#define TESSELLATION_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+
+namespace NURBS
+{
+
+/// @brief Axis Aligned Bounding Box. Empty Until The First Expand.
+struct BoundingBox
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return min.x > max.x;
+    }
+
+    void Expand(const glm::vec3& point) noexcept
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    void Expand(const BoundingBox& bounding_box) noexcept
+    {
+        if (!bounding_box.Empty())
+        {
+            Expand(bounding_box.min);
+            Expand(bounding_box.max);
+        }
+    }
+};
+
+/// @brief Indices Of All Nonempty Knot Spans [u_span, u_{span+1}) In [degree, knots.size() - degree - 2].
+/// These Are Exactly The Spans FindSpan Can Return.
+inline std::vector<size_t> KnotSpans(const size_t degree, const std::vector<float>& knots)
+{
+    std::vector<size_t> spans;
+    for (size_t span = degree; span + degree + 1 < knots.size(); ++span)
+    {
+        if (knots[span] < knots[span+1])
+        {
+            spans.push_back(span);
+        }
+    }
+    return spans;
+}
+
+/// @brief Tessellation Of The Tile [u_{u_span}, u_{u_span+1}] x [v_{v_span}, v_{v_span+1}].
+///
+/// points And normals Are (resolution + 1) x (resolution + 1) Grids, points[a * (resolution + 1) + b] Is At
+/// u = lerp(u_{u_span}, u_{u_span+1}, a / resolution), v = lerp(v_{v_span}, v_{v_span+1}, b / resolution).
+/// Only Control Points [u_span-degree_u, u_span] x [v_span-degree_v, v_span] Affect A Tile (Local Support).
+///
+struct SurfaceTile
+{
+    size_t u_span = 0;
+    size_t v_span = 0;
+    size_t resolution = 0;
+    std::vector<glm::vec3> points;
+    std::vector<glm::vec3> normals;
+    BoundingBox bounding_box;
+};
+
+/// @brief (Re)Evaluate points, normals And bounding_box Of tile In Place, Reusing Its Buffers.
+///
+/// Basis Functions Are Evaluated Once Per Grid Line Instead Of Once Per Sample, And The Span Is Fixed So Samples
+/// On The Tile Border Use The Same Span As The Interior. Normals Follow SurfaceNormal: cross(S_v, S_u).
+///
+inline void TessellateTile(const tinynurbs::RationalSurface<float>& srf, SurfaceTile& tile)
+{
+    assert(tile.resolution > 0);
+
+    const size_t degree_u = srf.degree_u;
+    const size_t degree_v = srf.degree_v;
+    const size_t samples = tile.resolution + 1;
+
+    const float u_min = srf.knots_u[tile.u_span], u_max = srf.knots_u[tile.u_span+1];
+    const float v_min = srf.knots_v[tile.v_span], v_max = srf.knots_v[tile.v_span+1];
+
+    // u_b_spline_der_basis[a] Is {N, N'} At The a-th u Sample. Same For v.
+    std::vector<std::vector<std::vector<float>>> u_b_spline_der_basis(samples);
+    std::vector<std::vector<std::vector<float>>> v_b_spline_der_basis(samples);
+
+    for (size_t a = 0; a < samples; ++a)
+    {
+        const float t = (float)a / (float)tile.resolution;
+        u_b_spline_der_basis[a] = BSplineDerBasis(degree_u, tile.u_span, srf.knots_u, u_min + t * (u_max - u_min), 1);
+        v_b_spline_der_basis[a] = BSplineDerBasis(degree_v, tile.v_span, srf.knots_v, v_min + t * (v_max - v_min), 1);
+    }
+
+    // Only The (degree_u + 1) x (degree_v + 1) Local Control Points Are Needed.
+    std::vector homo_control_points(degree_u + 1, std::vector<glm::vec4>(degree_v + 1));
+
+    for (size_t i = 0; i <= degree_u; ++i)
+    {
+        for (size_t j = 0; j <= degree_v; ++j)
+        {
+            const size_t r = tile.u_span - degree_u + i;
+            const size_t s = tile.v_span - degree_v + j;
+            homo_control_points[i][j] = glm::vec4(srf.control_points(r, s) * srf.weights(r, s), srf.weights(r, s));
+        }
+    }
+
+    tile.points.resize(samples * samples);
+    tile.normals.resize(samples * samples);
+    tile.bounding_box = BoundingBox();
+
+    for (size_t a = 0; a < samples; ++a)
+    {
+        const auto& Nu = u_b_spline_der_basis[a];
+        for (size_t b = 0; b < samples; ++b)
+        {
+            const auto& Nv = v_b_spline_der_basis[b];
+
+            glm::vec4 A(0.0f), Au(0.0f), Av(0.0f);
+
+            for (size_t j = 0; j <= degree_v; ++j)
+            {
+                glm::vec4 tmp(0.0f), tmp_u(0.0f);
+                for (size_t i = 0; i <= degree_u; ++i)
+                {
+                    tmp += Nu[0][i] * homo_control_points[i][j];
+                    tmp_u += Nu[1][i] * homo_control_points[i][j];
+                }
+                A += Nv[0][j] * tmp;
+                Au += Nv[0][j] * tmp_u;
+                Av += Nv[1][j] * tmp;
+            }
+
+            const glm::vec3 point = glm::vec3(A) / A.w;
+            const glm::vec3 Su = (glm::vec3(Au) - Au.w * point) / A.w;
+            const glm::vec3 Sv = (glm::vec3(Av) - Av.w * point) / A.w;
+            const glm::vec3 n = glm::cross(Sv, Su);
+
+            tile.points[a * samples + b] = point;
+            tile.normals[a * samples + b] = glm::length(n) <= std::numeric_limits<float>::epsilon() ? glm::vec3(0.0f) : glm::normalize(n);
+            tile.bounding_box.Expand(point);
+        }
+    }
+}
+
+}
+
+#endif //TESSELLATION_H
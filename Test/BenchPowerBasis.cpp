@@ -0,0 +1,199 @@
+/**
+  ******************************************************************************
+  * @file           : BenchPowerBasis.cpp
+  * @author         : AliceRemake
+  * @brief          : Speed And Accuracy Of PowerBasis.h Versus The B-Spline Form
+  * @attention      : Not A Test, Prints A Report
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <NURBS.h>
+#include <PowerBasis.h>
+#include <tinynurbs/tinynurbs.h>
+
+template <typename Function>
+static double Milliseconds(const Function& function)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Nonzero Basis Functions In Double, A2.2 In The NURBS Book.
+static std::vector<double> ReferenceBasis(const size_t degree, const std::vector<float>& knots, const size_t span, const double u)
+{
+    std::vector<double> basis(degree + 1, 0.0), left(degree + 1, 0.0), right(degree + 1, 0.0);
+    basis[0] = 1.0;
+    for (size_t j = 1; j <= degree; ++j)
+    {
+        left[j] = u - knots[span+1-j];
+        right[j] = knots[span+j] - u;
+        double saved = 0.0;
+        for (size_t r = 0; r < j; ++r)
+        {
+            const double temp = basis[r] / (right[r+1] + left[j-r]);
+            basis[r] = saved + right[r+1] * temp;
+            saved = left[j-r] * temp;
+        }
+        basis[j] = saved;
+    }
+    return basis;
+}
+
+// B-Spline Form Evaluated In Double, Independent Of The Power Basis Conversion.
+static glm::dvec3 ReferenceCurvePoint(const tinynurbs::RationalCurve3f& crv, const float u)
+{
+    const size_t span = NURBS::FindSpan(crv.degree, crv.knots, u);
+    const auto basis = ReferenceBasis(crv.degree, crv.knots, span, u);
+    glm::dvec4 point(0.0);
+    for (size_t i = 0; i <= crv.degree; ++i)
+    {
+        const size_t index = span - crv.degree + i;
+        const double w = crv.weights[index];
+        point += basis[i] * glm::dvec4(glm::dvec3(crv.control_points[index]) * w, w);
+    }
+    return glm::dvec3(point) / point.w;
+}
+
+static glm::dvec3 ReferenceSurfacePoint(const tinynurbs::RationalSurface3f& srf, const float u, const float v)
+{
+    const size_t u_span = NURBS::FindSpan(srf.degree_u, srf.knots_u, u);
+    const size_t v_span = NURBS::FindSpan(srf.degree_v, srf.knots_v, v);
+    const auto u_basis = ReferenceBasis(srf.degree_u, srf.knots_u, u_span, u);
+    const auto v_basis = ReferenceBasis(srf.degree_v, srf.knots_v, v_span, v);
+    glm::dvec4 point(0.0);
+    for (size_t k = 0; k <= srf.degree_u; ++k)
+    {
+        for (size_t l = 0; l <= srf.degree_v; ++l)
+        {
+            const size_t i = u_span - srf.degree_u + k;
+            const size_t j = v_span - srf.degree_v + l;
+            const double w = srf.weights(i, j);
+            point += u_basis[k] * v_basis[l] * glm::dvec4(glm::dvec3(srf.control_points(i, j)) * w, w);
+        }
+    }
+    return glm::dvec3(point) / point.w;
+}
+
+int main()
+{
+    constexpr size_t num_spans = 16;
+    constexpr size_t num_samples = 1 << 20;
+    constexpr size_t grid = 1 << 10;
+
+    std::mt19937 rng(30);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> weight(0.5f, 2.0f);
+
+    tinynurbs::RationalCurve3f crv;
+    crv.degree = 3;
+    crv.knots.assign(4, 0.0f);
+    for (size_t i = 1; i < num_spans; ++i)
+    {
+        crv.knots.push_back((float)i / num_spans);
+    }
+    crv.knots.insert(crv.knots.end(), 4, 1.0f);
+    for (size_t i = 0; i < num_spans + 3; ++i)
+    {
+        crv.control_points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        crv.weights.push_back(weight(rng));
+    }
+
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 3;
+    srf.knots_u = crv.knots;
+    srf.knots_v = crv.knots;
+    srf.control_points = {num_spans + 3, num_spans + 3};
+    srf.weights = {num_spans + 3, num_spans + 3};
+    for (size_t i = 0; i < num_spans + 3; ++i)
+    {
+        for (size_t j = 0; j < num_spans + 3; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+            srf.weights(i, j) = weight(rng);
+        }
+    }
+
+    const auto curve_float = NURBS::ToPowerBasis<float>(crv);
+    const auto curve_double = NURBS::ToPowerBasis<double>(crv);
+    const auto surface_float = NURBS::ToPowerBasis<float>(srf);
+    const auto surface_double = NURBS::ToPowerBasis<double>(srf);
+
+    std::vector<glm::vec3> bspline(num_samples), power_float(num_samples);
+    std::vector<glm::dvec3> power_double(num_samples);
+    NURBS::EvaluationContext context;
+
+    std::printf("CurvePoint, degree 3, %zu spans, %zu samples\n", num_spans, num_samples);
+    std::printf("  B-spline float         %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < num_samples; ++i) { bspline[i] = NURBS::CurvePoint(context, crv, (float)i / (num_samples - 1)); } }));
+    std::printf("  Power basis float      %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < num_samples; ++i) { power_float[i] = NURBS::CurvePoint(curve_float, (float)i / (num_samples - 1)); } }));
+    std::printf("  Power basis double     %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < num_samples; ++i) { power_double[i] = NURBS::CurvePoint(curve_double, (double)((float)i / (num_samples - 1))); } }));
+
+    // The Reference Is The B-Spline Form In Double, So The Double Power Basis Error Is That Of The Conversion Itself.
+    double bspline_error = 0.0, power_float_error = 0.0, power_double_error = 0.0;
+    for (size_t i = 0; i < num_samples; ++i)
+    {
+        const glm::dvec3 reference = ReferenceCurvePoint(crv, (float)i / (num_samples - 1));
+        bspline_error = std::max(bspline_error, glm::distance(glm::dvec3(bspline[i]), reference));
+        power_float_error = std::max(power_float_error, glm::distance(glm::dvec3(power_float[i]), reference));
+        power_double_error = std::max(power_double_error, glm::distance(power_double[i], reference));
+    }
+    std::printf("  Max error vs double B-spline: B-spline float %.3e, power basis float %.3e, power basis double %.3e\n",
+                bspline_error, power_float_error, power_double_error);
+
+    bspline.resize(grid * grid);
+    power_float.resize(grid * grid);
+    power_double.resize(grid * grid);
+
+    std::printf("SurfacePoint, degree 3x3, %zux%zu spans, %zux%zu samples\n", num_spans, num_spans, grid, grid);
+    std::printf("  B-spline float         %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < grid; ++i) for (size_t j = 0; j < grid; ++j) { bspline[i * grid + j] = NURBS::SurfacePoint(context, srf, (float)i / (grid - 1), (float)j / (grid - 1)); } }));
+    std::printf("  Power basis float      %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < grid; ++i) for (size_t j = 0; j < grid; ++j) { power_float[i * grid + j] = NURBS::SurfacePoint(surface_float, (float)i / (grid - 1), (float)j / (grid - 1)); } }));
+    std::printf("  Power basis double     %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < grid; ++i) for (size_t j = 0; j < grid; ++j) { power_double[i * grid + j] = NURBS::SurfacePoint(surface_double, (double)((float)i / (grid - 1)), (double)((float)j / (grid - 1))); } }));
+
+    bspline_error = 0.0, power_float_error = 0.0, power_double_error = 0.0;
+    for (size_t i = 0; i < grid; ++i)
+    {
+        for (size_t j = 0; j < grid; ++j)
+        {
+            const glm::dvec3 reference = ReferenceSurfacePoint(srf, (float)i / (grid - 1), (float)j / (grid - 1));
+            bspline_error = std::max(bspline_error, glm::distance(glm::dvec3(bspline[i * grid + j]), reference));
+            power_float_error = std::max(power_float_error, glm::distance(glm::dvec3(power_float[i * grid + j]), reference));
+            power_double_error = std::max(power_double_error, glm::distance(power_double[i * grid + j], reference));
+        }
+    }
+    std::printf("  Max error vs double B-spline: B-spline float %.3e, power basis float %.3e, power basis double %.3e\n",
+                bspline_error, power_float_error, power_double_error);
+
+    // First Derivatives, Both Forms Against Each Other Relative To Their Size.
+    constexpr size_t der_grid = grid / 4;
+    std::vector<std::array<glm::vec3, 4>> bspline_ders(der_grid * der_grid);
+    std::vector<std::vector<std::vector<glm::vec3>>> power_ders(der_grid * der_grid);
+    std::printf("SurfaceDerivatives, first order, %zux%zu samples\n", der_grid, der_grid);
+    std::printf("  B-spline float         %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < der_grid; ++i) for (size_t j = 0; j < der_grid; ++j) { NURBS::SurfaceDerivatives(context, srf, 1, (float)i / (der_grid - 1), (float)j / (der_grid - 1), bspline_ders[i * der_grid + j]); } }));
+    std::printf("  Power basis float      %8.2f ms\n", Milliseconds([&] {
+        for (size_t i = 0; i < der_grid; ++i) for (size_t j = 0; j < der_grid; ++j) { power_ders[i * der_grid + j] = NURBS::SurfaceDerivatives(surface_float, 1, (float)i / (der_grid - 1), (float)j / (der_grid - 1)); } }));
+
+    double der_error = 0.0;
+    for (size_t i = 0; i < der_grid * der_grid; ++i)
+    {
+        // bspline_ders Is Laid Out [k * 2 + l].
+        for (const auto& [k, l] : { std::pair<size_t, size_t>{ 1, 0 }, { 0, 1 } })
+        {
+            const glm::vec3& der = bspline_ders[i][k * 2 + l];
+            der_error = std::max(der_error, (double)glm::distance(power_ders[i][k][l], der) / (1.0 + glm::length(der)));
+        }
+    }
+    std::printf("  Max relative difference power basis float vs B-spline float: %.3e\n", der_error);
+
+    return 0;
+}
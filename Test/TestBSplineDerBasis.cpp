@@ -74,3 +74,31 @@ TEST_CASE("BSplineDerBasis")
     CHECK_FLOAT_MATRIX(NURBS::BSplineDerBasis(degree, NURBS::FindSpan(degree, knots, 5.0f), knots, 5.0f, 4), tinynurbs::bsplineDerBasis(degree, tinynurbs::findSpan(degree, knots, 5.0f), knots, 5.0f, 4));
 
 }
+
+TEST_CASE("BSplineDerBasisQuartic")
+{
+    // Quartic Bezier: The Basis Functions Are B_{i,4}(u) = C(4,i) u^i (1-u)^(4-i). For k >= 2 Derivatives Some
+    // Functions d Have d > k, Where The Inner Sum Of A2.3 Starts At j = 1.
+    constexpr size_t degree = 4;
+    const std::vector knots = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    const auto ders = NURBS::BSplineDerBasis(degree, NURBS::FindSpan(degree, knots, 0.5f), knots, 0.5f, 4);
+
+    // By Hand At u = 1/2: B^(k)_{i,4} = 4!/(4-k)! * Sum_m (-1)^(k-m) C(k,m) B_{i-k+m,4-k}(1/2).
+    const std::array<std::array<float, degree + 1>, 5> expected = {{
+        { 1.0f / 16.0f, 4.0f / 16.0f, 6.0f / 16.0f, 4.0f / 16.0f, 1.0f / 16.0f },
+        { -0.5f, -1.0f, 0.0f, 1.0f, 0.5f },
+        { 3.0f, 0.0f, -6.0f, 0.0f, 3.0f },
+        { -12.0f, 24.0f, 0.0f, -24.0f, 12.0f },
+        { 24.0f, -96.0f, 144.0f, -96.0f, 24.0f },
+    }};
+
+    REQUIRE(ders.size() == 5);
+    for (size_t k = 0; k <= 4; ++k)
+    {
+        REQUIRE(ders[k].size() == degree + 1);
+        for (size_t i = 0; i <= degree; ++i)
+        {
+            CHECK(std::fabs(ders[k][i] - expected[k][i]) < 1e-4f);
+        }
+    }
+}
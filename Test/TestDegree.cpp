@@ -0,0 +1,165 @@
+/**
+  ******************************************************************************
+  * @file           : TestDegree.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Degree.h>
+#include <tinynurbs/tinynurbs.h>
+
+static float CurveDistance(const tinynurbs::RationalCurve3f& lhs, const tinynurbs::RationalCurve3f& rhs)
+{
+    float distance = 0.0f;
+    for (size_t k = 0; k <= 500; ++k)
+    {
+        const float u = (float)k / 500.0f;
+        distance = std::max(distance, glm::distance(NURBS::CurvePoint(lhs, u), NURBS::CurvePoint(rhs, u)));
+    }
+    return distance;
+}
+
+static float SurfaceDistance(const tinynurbs::RationalSurface3f& lhs, const tinynurbs::RationalSurface3f& rhs)
+{
+    float distance = 0.0f;
+    for (size_t k = 0; k <= 40; ++k)
+    {
+        for (size_t l = 0; l <= 40; ++l)
+        {
+            const float u = (float)k / 40.0f, v = (float)l / 40.0f;
+            distance = std::max(distance, glm::distance(NURBS::SurfacePoint(lhs, u, v), NURBS::SurfacePoint(rhs, u, v)));
+        }
+    }
+    return distance;
+}
+
+static tinynurbs::RationalSurface3f Sphere()
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 3;
+    srf.knots_u = {0, 0, 0, 0, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0, 1, 1, 1, 1};
+    // https://www.geometrictools.com/Documentation/NURBSCircleSphere.pdf
+    srf.control_points = {4, 4,
+                          {glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1),
+                           glm::vec3(2, 0, 1), glm::vec3(2, 4, 1),  glm::vec3(-2, 4, 1),  glm::vec3(-2, 0, 1),
+                           glm::vec3(2, 0, -1), glm::vec3(2, 4, -1), glm::vec3(-2, 4, -1), glm::vec3(-2, 0, -1),
+                           glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1)
+                          }
+    };
+    srf.weights = {4, 4,
+                   {1,       1.f/3.f, 1.f/3.f, 1,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1,       1.f/3.f, 1.f/3.f, 1
+                   }
+    };
+    return srf;
+}
+
+TEST_CASE("ElevateCurveDegree")
+{
+    const tinynurbs::RationalCurve3f crv(
+        3,
+        { 0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f },
+        { glm::vec3(0, 0, 0), glm::vec3(1, 2, 0), glm::vec3(2, 0, 1), glm::vec3(3, 1, 1), glm::vec3(4, 4, 0), glm::vec3(5, 0, 2), glm::vec3(6, 1, 0) },
+        { 1.0f, 2.0f, 0.5f, 1.0f, 3.0f, 1.0f, 1.5f }
+    );
+
+    for (const size_t t : { 0, 1, 2, 3 })
+    {
+        const auto elevated = NURBS::ElevateDegree(crv, t);
+        CHECK(elevated.degree == 3 + t);
+        // Three Spans, Each Adding t Control Points.
+        CHECK(elevated.control_points.size() == 7 + 3 * t);
+        CHECK(elevated.knots.size() == elevated.control_points.size() + elevated.degree + 1);
+        CHECK(CurveDistance(crv, elevated) < 1e-4f);
+    }
+}
+
+TEST_CASE("ReduceCurveDegree")
+{
+    const tinynurbs::RationalCurve3f crv(
+        3,
+        { 0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f },
+        { glm::vec3(0, 0, 0), glm::vec3(1, 2, 0), glm::vec3(2, 0, 1), glm::vec3(3, 1, 1), glm::vec3(4, 4, 0), glm::vec3(5, 0, 2), glm::vec3(6, 1, 0) },
+        { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f }
+    );
+
+    // Elevated Curves Reduce Back Exactly.
+    for (const size_t t : { 1, 2, 3 })
+    {
+        const auto elevated = NURBS::ElevateDegree(crv, t);
+        auto reduced = NURBS::ReduceDegree(elevated, 1e-3f);
+        REQUIRE(reduced.has_value());
+        CHECK(reduced->degree == 2 + t);
+        CHECK(reduced->knots == NURBS::ElevatedKnots(crv.knots, t - 1));
+        CHECK(CurveDistance(crv, *reduced) < 1e-3f);
+
+        reduced = NURBS::ToDegree(elevated, 3, 1e-3f);
+        REQUIRE(reduced.has_value());
+        CHECK(reduced->degree == 3);
+        for (size_t i = 0; i < crv.control_points.size(); ++i)
+        {
+            CHECK(glm::distance(reduced->control_points[i], crv.control_points[i]) < 1e-3f);
+        }
+    }
+
+    // A Genuine Cubic Is Not Within A Small Tolerance Of A Quadratic.
+    CHECK_FALSE(NURBS::ReduceDegree(crv, 1e-3f).has_value());
+    const auto linear = NURBS::ToDegree(crv, 1, 1e3f);
+    REQUIRE(linear.has_value());
+    CHECK(linear->degree == 1);
+    CHECK(CurveDistance(crv, *linear) <= 1e3f);
+
+    // With A Tolerance Loose Enough To Reduce, The Bound Holds.
+    for (const float tolerance : { 10.0f, 30.0f })
+    {
+        const auto reduced = NURBS::ReduceDegree(crv, tolerance);
+        REQUIRE(reduced.has_value());
+        CHECK(reduced->degree == 2);
+        CHECK(CurveDistance(crv, *reduced) <= tolerance);
+    }
+    const auto rational = NURBS::ElevateDegree(tinynurbs::RationalCurve3f(crv.degree, crv.knots, crv.control_points, { 1.0f, 2.0f, 0.5f, 1.0f, 3.0f, 1.0f, 1.5f }), 1);
+    for (const float tolerance : { 1e-4f, 0.1f, 1.0f })
+    {
+        const auto reduced = NURBS::ReduceDegree(rational, tolerance);
+        REQUIRE(reduced.has_value());
+        CHECK(reduced->degree == 3);
+        CHECK(CurveDistance(rational, *reduced) <= tolerance);
+    }
+}
+
+TEST_CASE("SurfaceDegree")
+{
+    const auto srf = Sphere();
+
+    const auto elevated = NURBS::ElevateDegree(srf, 1, 2);
+    CHECK(elevated.degree_u == 4);
+    CHECK(elevated.degree_v == 5);
+    CHECK(elevated.control_points.rows() == 5);
+    CHECK(elevated.control_points.cols() == 6);
+    CHECK(SurfaceDistance(srf, elevated) < 1e-4f);
+
+    const auto reduced_u = NURBS::ReduceDegree(elevated, true, 1e-3f);
+    REQUIRE(reduced_u.has_value());
+    CHECK(reduced_u->degree_u == 3);
+    CHECK(reduced_u->control_points.rows() == 4);
+    CHECK(reduced_u->control_points.cols() == 6);
+    CHECK(SurfaceDistance(srf, *reduced_u) < 1e-3f);
+
+    const auto normalized = NURBS::ToDegree(elevated, 3, 3, 1e-3f);
+    REQUIRE(normalized.has_value());
+    CHECK(SurfaceDistance(srf, *normalized) < 1e-3f);
+
+    // Exactly Reducible In v, But Only To Zero Weights.
+    CHECK_FALSE(NURBS::ReduceDegree(srf, false, 1e-3f).has_value());
+}
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file           : TestEditableSurface.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <EditableSurface.h>
+#include <tinynurbs/tinynurbs.h>
+
+#define CHECK_GLM_VERTEX(lhs, rhs) CHECK((glm::distance(lhs, rhs) < 1e-5f))
+
+static void CheckTiles(const NURBS::EditableSurface& editable)
+{
+    const auto& srf = editable.Surface();
+    for (const auto& tile : editable.Tiles())
+    {
+        const size_t samples = tile.resolution + 1;
+        for (size_t a = 0; a < samples; ++a)
+        {
+            for (size_t b = 0; b < samples; ++b)
+            {
+                const float u = srf.knots_u[tile.u_span] + (srf.knots_u[tile.u_span+1] - srf.knots_u[tile.u_span]) * (float)a / (float)tile.resolution;
+                const float v = srf.knots_v[tile.v_span] + (srf.knots_v[tile.v_span+1] - srf.knots_v[tile.v_span]) * (float)b / (float)tile.resolution;
+                CHECK_GLM_VERTEX(tile.points[a * samples + b], NURBS::SurfacePoint(srf, u, v));
+                CHECK_GLM_VERTEX(tile.normals[a * samples + b], NURBS::SurfaceNormal(srf, u, v));
+            }
+        }
+    }
+}
+
+TEST_CASE("EditableSurface")
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 3;
+    srf.knots_u = {0, 0, 0, 0, 0.25f, 0.5f, 0.75f, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0, 0.25f, 0.5f, 0.75f, 1, 1, 1, 1};
+    srf.control_points = {7, 7};
+    srf.weights = {7, 7};
+    for (size_t i = 0; i < 7; ++i)
+    {
+        for (size_t j = 0; j < 7; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3((float)i, (float)j, std::sin((float)(i + 2 * j)));
+            srf.weights(i, j) = 1.0f + 0.1f * (float)((i + j) % 3);
+        }
+    }
+
+    NURBS::EditableSurface editable(srf, 4);
+    CHECK(editable.Rows() == 4);
+    CHECK(editable.Cols() == 4);
+    CHECK_FALSE(editable.Dirty());
+    CheckTiles(editable);
+
+    // Corner Control Point Only Affects The Corner Tile.
+    editable.SetControlPoint(0, 0, glm::vec3(-1, -1, 2));
+    CHECK(editable.Dirty());
+    CHECK(editable.Update() == 1);
+    CHECK_FALSE(editable.Dirty());
+    CheckTiles(editable);
+
+    // Center Control Point Affects Spans [3, 6] x [3, 6], Every Tile.
+    editable.SetWeight(3, 3, 4.0f);
+    CHECK(editable.Update() == 16);
+    CheckTiles(editable);
+
+    // Overlapping Edits Are Merged.
+    editable.SetControlPoint(1, 1, glm::vec3(1, 1, 3));
+    editable.SetControlPoint(1, 2, glm::vec3(1, 2, 3));
+    CHECK(editable.Update() == 6);
+    CheckTiles(editable);
+
+    for (const auto& tile : editable.Tiles())
+    {
+        CHECK(glm::min(tile.bounding_box.min, editable.Bounds().min) == editable.Bounds().min);
+        CHECK(glm::max(tile.bounding_box.max, editable.Bounds().max) == editable.Bounds().max);
+    }
+
+    CHECK(editable.Update() == 0);
+}
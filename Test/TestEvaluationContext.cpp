@@ -0,0 +1,236 @@
+/**
+  ******************************************************************************
+  * @file           : TestEvaluationContext.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <tinynurbs/tinynurbs.h>
+
+#define CHECK_GLM_VERTEX(lhs, rhs) CHECK((glm::distance(lhs, rhs) < 2 * std::numeric_limits<float>::epsilon()))
+#define CHECK_GLM_REFERENCE(lhs, rhs) CHECK((glm::distance(glm::dvec3(lhs), rhs) < 1e-4 * std::max(1.0, glm::length(rhs))))
+
+// Independent References: Bernstein Polynomials In Double Precision Instead Of Cox-de Boor In Float.
+
+/// @brief k-th Derivative Of B_{i,n}(u), Zero Outside 0 <= i <= n.
+static double Bernstein(const int n, const int i, const int k, const double u)
+{
+    if (i < 0 || i > n)
+    {
+        return 0.0;
+    }
+    if (k == 0)
+    {
+        double binomial = 1.0;
+        for (int j = 1; j <= i; ++j)
+        {
+            binomial = binomial * (n - i + j) / j;
+        }
+        return binomial * std::pow(u, i) * std::pow(1.0 - u, n - i);
+    }
+    return n * (Bernstein(n - 1, i - 1, k - 1, u) - Bernstein(n - 1, i, k - 1, u));
+}
+
+static double Choose(const size_t n, const size_t k)
+{
+    double binomial = 1.0;
+    for (size_t j = 1; j <= k; ++j)
+    {
+        binomial = binomial * (double)(n - k + j) / (double)j;
+    }
+    return binomial;
+}
+
+/// @brief Derivatives 0..num_ders Of A Rational Bezier Curve By The Quotient Rule.
+static std::vector<glm::dvec3> ReferenceCurveDerivatives(const tinynurbs::RationalCurve3f& crv, const size_t num_ders, const double u)
+{
+    const int n = (int)crv.degree;
+    std::vector<glm::dvec3> A(num_ders + 1, glm::dvec3(0.0)), C(num_ders + 1);
+    std::vector<double> W(num_ders + 1, 0.0);
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        for (int i = 0; i <= n; ++i)
+        {
+            const double b = Bernstein(n, i, (int)k, u);
+            A[k] += b * (double)crv.weights[i] * glm::dvec3(crv.control_points[i]);
+            W[k] += b * (double)crv.weights[i];
+        }
+    }
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        glm::dvec3 v = A[k];
+        for (size_t i = 1; i <= k; ++i)
+        {
+            v -= Choose(k, i) * W[i] * C[k-i];
+        }
+        C[k] = v / W[0];
+    }
+    return C;
+}
+
+/// @brief Derivatives S_{k,l}, k + l <= num_ders, Of A Rational Bezier Surface, At [k][l]. Others Are Zero.
+static std::vector<std::vector<glm::dvec3>> ReferenceSurfaceDerivatives(const tinynurbs::RationalSurface3f& srf, const size_t num_ders, const double u, const double v)
+{
+    const int p = (int)srf.degree_u, q = (int)srf.degree_v;
+    std::vector A(num_ders + 1, std::vector(num_ders + 1, glm::dvec3(0.0)));
+    std::vector W(num_ders + 1, std::vector(num_ders + 1, 0.0));
+    std::vector S(num_ders + 1, std::vector(num_ders + 1, glm::dvec3(0.0)));
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        for (size_t l = 0; k + l <= num_ders; ++l)
+        {
+            for (int i = 0; i <= p; ++i)
+            {
+                for (int j = 0; j <= q; ++j)
+                {
+                    const double b = Bernstein(p, i, (int)k, u) * Bernstein(q, j, (int)l, v);
+                    A[k][l] += b * (double)srf.weights(i, j) * glm::dvec3(srf.control_points(i, j));
+                    W[k][l] += b * (double)srf.weights(i, j);
+                }
+            }
+        }
+    }
+    for (size_t k = 0; k <= num_ders; ++k)
+    {
+        for (size_t l = 0; k + l <= num_ders; ++l)
+        {
+            glm::dvec3 value = A[k][l];
+            for (size_t j = 1; j <= l; ++j)
+            {
+                value -= Choose(l, j) * W[0][j] * S[k][l-j];
+            }
+            for (size_t i = 1; i <= k; ++i)
+            {
+                value -= Choose(k, i) * W[i][0] * S[k-i][l];
+                for (size_t j = 1; j <= l; ++j)
+                {
+                    value -= Choose(k, i) * Choose(l, j) * W[i][j] * S[k-i][l-j];
+                }
+            }
+            S[k][l] = value / W[0][0];
+        }
+    }
+    return S;
+}
+
+/// @brief Forwards To upstream And Counts Allocations.
+class CountingResource final : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, const size_t bytes, const size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_CASE("EvaluationContext")
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 3;
+    srf.knots_u = {0, 0, 0, 0, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0, 1, 1, 1, 1};
+    // 4x4 grid (tinynurbs::array2) of control points and weights
+    // https://www.geometrictools.com/Documentation/NURBSCircleSphere.pdf
+    srf.control_points = {4, 4, 
+                          {glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1),
+                           glm::vec3(2, 0, 1), glm::vec3(2, 4, 1),  glm::vec3(-2, 4, 1),  glm::vec3(-2, 0, 1),
+                           glm::vec3(2, 0, -1), glm::vec3(2, 4, -1), glm::vec3(-2, 4, -1), glm::vec3(-2, 0, -1),
+                           glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1)
+                          }
+    };
+    srf.weights = {4, 4,
+                   {1,       1.f/3.f, 1.f/3.f, 1,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1,       1.f/3.f, 1.f/3.f, 1
+                   }
+    };
+
+    const tinynurbs::RationalCurve crv(
+        2,
+        std::vector{ 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f },
+        std::vector{ glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 0, 0) },
+        std::vector{ 1.0f, 2.0f, 3.0f }
+    );
+
+    constexpr size_t num_ders = 3;
+
+    CountingResource resource;
+    NURBS::EvaluationContext context(&resource);
+    std::array<glm::vec3, num_ders + 1> curve_derivatives;
+    std::array<glm::vec3, (num_ders + 1) * (num_ders + 1)> surface_derivatives;
+
+    const auto evaluate = [&](const float u, const float v)
+    {
+        const auto reference_curve_derivatives = ReferenceCurveDerivatives(crv, num_ders, u);
+        const auto reference_surface_derivatives = ReferenceSurfaceDerivatives(srf, num_ders, u, v);
+
+        // The Context Overloads Against Independent References.
+        CHECK_GLM_REFERENCE(NURBS::CurvePoint(context, crv, u), reference_curve_derivatives[0]);
+        CHECK_GLM_REFERENCE(NURBS::SurfacePoint(context, srf, u, v), reference_surface_derivatives[0][0]);
+        // The Sphere: Points On It, Normals Along The Radius Away From The Collapsed Borders.
+        const glm::vec3 point = NURBS::SurfacePoint(context, srf, u, v);
+        CHECK(std::abs(glm::length(point) - 1.0f) < 1e-5f);
+        const glm::vec3 normal = NURBS::SurfaceNormal(context, srf, u, v);
+        if (u > 0.0f && u < 1.0f && v > 0.0f && v < 1.0f)
+        {
+            CHECK(std::abs(std::abs(glm::dot(normal, point)) - 1.0f) < 1e-4f);
+        }
+
+        NURBS::CurveDerivatives(context, crv, num_ders, u, curve_derivatives);
+        for (size_t k = 0; k <= num_ders; ++k)
+        {
+            CHECK_GLM_REFERENCE(curve_derivatives[k], reference_curve_derivatives[k]);
+        }
+
+        NURBS::SurfaceDerivatives(context, srf, num_ders, u, v, surface_derivatives);
+        for (size_t k = 0; k <= num_ders; ++k)
+        {
+            for (size_t l = 0; k + l <= num_ders; ++l)
+            {
+                CHECK_GLM_REFERENCE(surface_derivatives[k * (num_ders + 1) + l], reference_surface_derivatives[k][l]);
+            }
+        }
+
+        // The Wrappers Forward To The Same Code.
+        CHECK_GLM_VERTEX(NURBS::CurvePoint(context, crv, u), NURBS::CurvePoint(crv, u));
+        CHECK_GLM_VERTEX(NURBS::SurfaceNormal(context, srf, u, v), NURBS::SurfaceNormal(srf, u, v));
+    };
+
+    // Warm Up Grows Every Buffer To Its Final Size.
+    evaluate(0.5f, 0.5f);
+    const size_t warm = resource.allocations;
+    CHECK(warm > 0);
+
+    for (const auto u : { 0.0f,0.1f,0.2f,0.3f,0.4f,0.5f,0.6f,0.7f,0.8f,0.9f,1.0f })
+    {
+        for (const auto v : { 0.0f,0.1f,0.2f,0.3f,0.4f,0.5f,0.6f,0.7f,0.8f,0.9f,1.0f })
+        {
+            evaluate(u, v);
+        }
+    }
+
+    CHECK(resource.allocations == warm);
+}
@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file           : TestFitting.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Fitting.h>
+#include <tinynurbs/tinynurbs.h>
+
+TEST_CASE("BandedMatrix")
+{
+    // Tridiagonal [2 -1; -1 2 -1; ...], Solution Of A x = A * (1, 2, ..., n).
+    const size_t n = 6;
+    NURBS::BandedMatrix matrix(n, 1, 1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        matrix(i, i) = 2.0;
+        if (i > 0) matrix(i, i - 1) = -1.0;
+        if (i + 1 < n) matrix(i, i + 1) = -1.0;
+    }
+    std::vector<double> b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        b[i] = 2.0 * (double)(i + 1) - (i > 0 ? (double)i : 0.0) - (i + 1 < n ? (double)(i + 2) : 0.0);
+    }
+
+    REQUIRE(matrix.Factor());
+    matrix.Solve(std::span(b));
+    for (size_t i = 0; i < n; ++i)
+    {
+        CHECK(std::abs(b[i] - (double)(i + 1)) < 1e-12);
+    }
+}
+
+TEST_CASE("InterpolateCurve")
+{
+    std::vector<glm::vec3> points;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        const float t = (float)i * 0.05f;
+        points.emplace_back(std::cos(t) * (1.0f + 0.1f * t), std::sin(t), 0.2f * t);
+    }
+
+    for (const auto parametrization : { NURBS::Parametrization::Uniform, NURBS::Parametrization::ChordLength, NURBS::Parametrization::Centripetal })
+    {
+        for (const size_t degree : { 0, 1, 2, 3, 5 })
+        {
+            const auto crv = NURBS::InterpolateCurve(points, degree, parametrization);
+            const auto parameters = NURBS::FittingParameters(points, parametrization);
+            REQUIRE(crv.control_points.size() == points.size());
+            REQUIRE(crv.knots.size() == points.size() + degree + 1);
+
+            float error = 0.0f;
+            for (size_t k = 0; k < points.size(); ++k)
+            {
+                error = std::max(error, glm::distance(NURBS::CurvePoint(crv, parameters[k]), points[k]));
+            }
+            CHECK(error < 1e-4f);
+        }
+    }
+}
+
+TEST_CASE("InterpolationKnots")
+{
+    const std::vector<float> parameters = { 0.0f, 0.25f, 0.5f, 1.0f };
+    CHECK(NURBS::InterpolationKnots(0, parameters) == std::vector<float>{ 0.0f, 0.125f, 0.375f, 0.75f, 1.0f });
+    CHECK(NURBS::InterpolationKnots(1, parameters) == std::vector<float>{ 0.0f, 0.0f, 0.25f, 0.5f, 1.0f, 1.0f });
+    CHECK(NURBS::InterpolationKnots(2, parameters) == std::vector<float>{ 0.0f, 0.0f, 0.0f, 0.375f, 1.0f, 1.0f, 1.0f });
+}
+
+TEST_CASE("ApproximateCurve")
+{
+    // Dense Samples Of A Polynomial Curve, Reproduced By A Cubic With Few Control Points.
+    std::vector<glm::vec3> points;
+    const size_t m = 5000;
+    for (size_t k = 0; k <= m; ++k)
+    {
+        const float t = (float)k / (float)m;
+        points.emplace_back(t, t * t - 0.5f * t, 0.3f * t * t * t);
+    }
+
+    const auto crv = NURBS::ApproximateCurve(points, 3, 12);
+    const auto parameters = NURBS::FittingParameters(points, NURBS::Parametrization::ChordLength);
+    REQUIRE(crv.control_points.size() == 12);
+    REQUIRE(crv.knots.size() == 16);
+    CHECK(crv.control_points.front() == points.front());
+    CHECK(crv.control_points.back() == points.back());
+    CHECK(std::is_sorted(crv.knots.begin(), crv.knots.end()));
+
+    float error = 0.0f;
+    for (size_t k = 0; k <= m; ++k)
+    {
+        error = std::max(error, glm::distance(NURBS::CurvePoint(crv, parameters[k]), points[k]));
+    }
+    CHECK(error < 1e-3f);
+
+    // As Many Control Points As Data Points Interpolates.
+    std::vector<glm::vec3> few(points.begin(), points.begin() + 8);
+    const auto full = NURBS::ApproximateCurve(few, 2, few.size());
+    const auto few_parameters = NURBS::FittingParameters(few, NURBS::Parametrization::ChordLength);
+    for (size_t k = 0; k < few.size(); ++k)
+    {
+        CHECK(glm::distance(NURBS::CurvePoint(full, few_parameters[k]), few[k]) < 1e-4f);
+    }
+}
+
+static tinynurbs::array2<glm::vec3> Grid(const size_t rows, const size_t cols)
+{
+    tinynurbs::array2<glm::vec3> points(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        for (size_t j = 0; j < cols; ++j)
+        {
+            const float x = (float)i / (float)(rows - 1);
+            const float y = (float)j / (float)(cols - 1);
+            points(i, j) = glm::vec3(x, y, 0.5f * std::sin(3.0f * x) * std::cos(2.0f * y));
+        }
+    }
+    return points;
+}
+
+TEST_CASE("InterpolateSurface")
+{
+    const auto points = Grid(40, 30);
+
+    for (const size_t num_threads : { 1, 4 })
+    {
+        const auto srf = NURBS::InterpolateSurface(points, 3, 2, NURBS::Parametrization::ChordLength, num_threads);
+        const auto u_parameters = NURBS::FittingParameters(points, true, NURBS::Parametrization::ChordLength);
+        const auto v_parameters = NURBS::FittingParameters(points, false, NURBS::Parametrization::ChordLength);
+        REQUIRE(srf.control_points.rows() == 40);
+        REQUIRE(srf.control_points.cols() == 30);
+
+        float error = 0.0f;
+        for (size_t i = 0; i < points.rows(); ++i)
+        {
+            for (size_t j = 0; j < points.cols(); ++j)
+            {
+                error = std::max(error, glm::distance(NURBS::SurfacePoint(srf, u_parameters[i], v_parameters[j]), points(i, j)));
+            }
+        }
+        CHECK(error < 1e-4f);
+    }
+}
+
+TEST_CASE("ApproximateSurface")
+{
+    const auto points = Grid(300, 200);
+
+    const auto srf = NURBS::ApproximateSurface(points, 3, 3, 12, 10);
+    const auto u_parameters = NURBS::FittingParameters(points, true, NURBS::Parametrization::ChordLength);
+    const auto v_parameters = NURBS::FittingParameters(points, false, NURBS::Parametrization::ChordLength);
+    REQUIRE(srf.control_points.rows() == 12);
+    REQUIRE(srf.control_points.cols() == 10);
+    CHECK(srf.control_points(0, 0) == points(0, 0));
+    CHECK(srf.control_points(11, 9) == points(299, 199));
+
+    float error = 0.0f;
+    for (size_t i = 0; i < points.rows(); i += 7)
+    {
+        for (size_t j = 0; j < points.cols(); j += 7)
+        {
+            error = std::max(error, glm::distance(NURBS::SurfacePoint(srf, u_parameters[i], v_parameters[j]), points(i, j)));
+        }
+    }
+    CHECK(error < 1e-3f);
+}
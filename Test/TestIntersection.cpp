@@ -0,0 +1,104 @@
+/**
+  ******************************************************************************
+  * @file           : TestIntersection.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Intersection.h>
+#include <tinynurbs/tinynurbs.h>
+
+static tinynurbs::RationalSurface3f Plane(const glm::vec3& p00, const glm::vec3& p01, const glm::vec3& p10, const glm::vec3& p11)
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 1;
+    srf.degree_v = 1;
+    srf.knots_u = {0, 0, 1, 1};
+    srf.knots_v = {0, 0, 1, 1};
+    srf.control_points = {2, 2, {p00, p01, p10, p11}};
+    srf.weights = {2, 2, {1, 1, 1, 1}};
+    return srf;
+}
+
+static void CheckOnBothSurfaces(const NURBS::IntersectionCurve& curve, const tinynurbs::RationalSurface3f& srf0, const tinynurbs::RationalSurface3f& srf1)
+{
+    for (const auto& point : curve)
+    {
+        CHECK(glm::distance(NURBS::SurfacePoint(srf0, point.uv0.x, point.uv0.y), point.point) < 1e-4f);
+        CHECK(glm::distance(NURBS::SurfacePoint(srf1, point.uv1.x, point.uv1.y), point.point) < 1e-4f);
+    }
+}
+
+TEST_CASE("IntersectSurfaces")
+{
+    // z = x^2 + y^2 - 1/4 Over [-1, 1]^2, Exactly Biquadratic.
+    tinynurbs::RationalSurface3f paraboloid;
+    paraboloid.degree_u = 2;
+    paraboloid.degree_v = 2;
+    paraboloid.knots_u = {0, 0, 0, 1, 1, 1};
+    paraboloid.knots_v = {0, 0, 0, 1, 1, 1};
+    paraboloid.control_points = {3, 3};
+    paraboloid.weights = {3, 3, std::vector(9, 1.0f)};
+    const float coordinate[3] = { -1.0f, 0.0f, 1.0f };
+    const float square[3] = { 1.0f, -1.0f, 1.0f };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            paraboloid.control_points(i, j) = glm::vec3(coordinate[i], coordinate[j], square[i] + square[j] - 0.25f);
+        }
+    }
+
+    NURBS::IntersectionOptions options;
+    options.step = 0.02f;
+
+    SUBCASE("Closed")
+    {
+        // z = 0 Cuts The Circle x^2 + y^2 = 1/4.
+        const auto plane = Plane(glm::vec3(-2, -2, 0), glm::vec3(-2, 2, 0), glm::vec3(2, -2, 0), glm::vec3(2, 2, 0));
+        const auto curves = NURBS::IntersectSurfaces(paraboloid, plane, options);
+        REQUIRE(curves.size() == 1);
+
+        const auto& curve = curves.front();
+        CHECK(curve.size() > 100);
+        CHECK(glm::distance(curve.front().point, curve.back().point) < 1e-4f);
+        CheckOnBothSurfaces(curve, paraboloid, plane);
+        for (const auto& point : curve)
+        {
+            CHECK(std::abs(glm::length(glm::vec2(point.point.x, point.point.y)) - 0.5f) < 1e-4f);
+            CHECK(std::abs(point.point.z) < 1e-4f);
+        }
+    }
+
+    SUBCASE("Open")
+    {
+        // x = 0.2 Cuts The Parabola z = y^2 - 0.21, Ending On The Boundaries y = -1 And y = 1.
+        const auto plane = Plane(glm::vec3(0.2f, -2, -2), glm::vec3(0.2f, -2, 3), glm::vec3(0.2f, 2, -2), glm::vec3(0.2f, 2, 3));
+        const auto curves = NURBS::IntersectSurfaces(paraboloid, plane, options);
+        REQUIRE(curves.size() == 1);
+
+        const auto& curve = curves.front();
+        CheckOnBothSurfaces(curve, paraboloid, plane);
+        CHECK(std::abs(std::abs(curve.front().point.y) - 1.0f) < 1e-4f);
+        CHECK(std::abs(std::abs(curve.back().point.y) - 1.0f) < 1e-4f);
+        CHECK(curve.front().point.y * curve.back().point.y < 0.0f);
+        for (const auto& point : curve)
+        {
+            CHECK(std::abs(point.point.x - 0.2f) < 1e-4f);
+            CHECK(std::abs(point.point.z - (point.point.y * point.point.y - 0.21f)) < 1e-4f);
+        }
+    }
+
+    SUBCASE("Disjoint")
+    {
+        const auto plane = Plane(glm::vec3(-2, -2, 3), glm::vec3(-2, 2, 3), glm::vec3(2, -2, 3), glm::vec3(2, 2, 3));
+        CHECK(NURBS::IntersectSurfaces(paraboloid, plane, options).empty());
+    }
+}
@@ -0,0 +1,227 @@
+/**
+  ******************************************************************************
+  * @file           : TestKnotRemoval.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Bezier.h>
+#include <KnotRemoval.h>
+#include <tinynurbs/tinynurbs.h>
+
+static float CurveDistance(const tinynurbs::RationalCurve3f& lhs, const tinynurbs::RationalCurve3f& rhs)
+{
+    float distance = 0.0f;
+    for (size_t k = 0; k <= 500; ++k)
+    {
+        const float u = (float)k / 500.0f;
+        distance = std::max(distance, glm::distance(NURBS::CurvePoint(lhs, u), NURBS::CurvePoint(rhs, u)));
+    }
+    return distance;
+}
+
+// The Same Curve With Every Interior Knot At Full Multiplicity, From Its Bezier Segments.
+static tinynurbs::RationalCurve3f Refine(const tinynurbs::RationalCurve3f& crv)
+{
+    std::vector<glm::vec4> homo_control_points;
+    for (size_t i = 0; i < crv.control_points.size(); ++i)
+    {
+        homo_control_points.emplace_back(crv.control_points[i] * crv.weights[i], crv.weights[i]);
+    }
+    const auto segments = NURBS::DecomposeBezier(crv.degree, crv.knots, homo_control_points);
+    const auto breakpoints = NURBS::Breakpoints(crv.degree, crv.knots);
+
+    tinynurbs::RationalCurve3f refined;
+    refined.degree = crv.degree;
+    refined.knots.push_back(breakpoints.front());
+    for (const float breakpoint : breakpoints)
+    {
+        refined.knots.insert(refined.knots.end(), crv.degree, breakpoint);
+    }
+    refined.knots.push_back(breakpoints.back());
+
+    for (size_t s = 0; s < segments.size(); ++s)
+    {
+        for (size_t k = s == 0 ? 0 : 1; k <= crv.degree; ++k)
+        {
+            refined.control_points.push_back(glm::vec3(segments[s][k]) / segments[s][k].w);
+            refined.weights.push_back(segments[s][k].w);
+        }
+    }
+    return refined;
+}
+
+TEST_CASE("RemoveCurveKnot")
+{
+    const tinynurbs::RationalCurve3f crv(
+        3,
+        { 0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f },
+        { glm::vec3(0, 0, 0), glm::vec3(1, 2, 0), glm::vec3(2, 0, 1), glm::vec3(3, 1, 1), glm::vec3(4, 4, 0), glm::vec3(5, 0, 2), glm::vec3(6, 1, 0) },
+        { 1.0f, 2.0f, 0.5f, 1.0f, 3.0f, 1.0f, 1.5f }
+    );
+
+    auto refined = Refine(crv);
+    REQUIRE(refined.control_points.size() == 10);
+    CHECK(CurveDistance(crv, refined) < 1e-4f);
+
+    // 0.2 Was Inserted Twice, 0.5 Once.
+    CHECK(NURBS::RemoveKnot(refined, 0.2f, 3, 1e-4f) == 2);
+    CHECK(NURBS::RemoveKnot(refined, 0.5f, 3, 1e-4f) == 1);
+    CHECK(refined.knots == crv.knots);
+    CHECK(CurveDistance(crv, refined) < 1e-4f);
+
+    // The Original Knots Are Needed.
+    auto copy = crv;
+    CHECK(NURBS::RemoveKnot(copy, 0.2f, 1, 1e-4f) == 0);
+    CHECK(NURBS::RemoveKnot(copy, 0.3f, 1, 1.0f) == 0);
+    CHECK(copy.knots == crv.knots);
+    CHECK(CurveDistance(crv, copy) == 0.0f);
+
+    // Off The Original By A Little, Removal Needs A Matching Tolerance And Then Stays Within It.
+    auto perturbed = Refine(crv);
+    perturbed.control_points[3] += glm::vec3(0.0f, 0.01f, 0.0f);
+    copy = perturbed;
+    CHECK(NURBS::RemoveKnot(copy, 0.2f, 1, 1e-5f) == 0);
+    for (const float tolerance : { 0.2f, 1.0f, 5.0f })
+    {
+        copy = perturbed;
+        REQUIRE(NURBS::RemoveKnot(copy, 0.2f, 1, tolerance) == 1);
+        CHECK(copy.control_points.size() == 9);
+        CHECK(CurveDistance(perturbed, copy) <= tolerance);
+    }
+}
+
+TEST_CASE("SimplifyCurve")
+{
+    std::vector<float> knots = { 0, 0, 0, 0 };
+    std::vector<glm::vec3> control_points;
+    for (size_t i = 0; i < 12; ++i)
+    {
+        control_points.emplace_back((float)i, std::sin((float)i), 0.1f * (float)(i * i));
+        if (i >= 4)
+        {
+            knots.push_back((float)(i - 3) / 9.0f);
+        }
+    }
+    knots.insert(knots.end(), 4, 1.0f);
+    const tinynurbs::RationalCurve3f crv(3, knots, control_points, std::vector(12, 1.0f));
+
+    auto refined = Refine(crv);
+    const size_t refined_size = refined.control_points.size();
+    auto report = NURBS::Simplify(refined, 1e-4f);
+    CHECK(report.control_points_before == refined_size);
+    CHECK(report.control_points_after == 12);
+    CHECK(report.knots_removed == refined_size - 12);
+    CHECK(report.max_deviation < 1e-4f);
+    CHECK(CurveDistance(crv, refined) < 1e-4f);
+
+    for (const float tolerance : { 0.01f, 0.1f, 1.0f })
+    {
+        auto simplified = crv;
+        report = NURBS::Simplify(simplified, tolerance);
+        CHECK(report.control_points_after == simplified.control_points.size());
+        CHECK(report.max_deviation <= tolerance);
+        CHECK(CurveDistance(crv, simplified) <= tolerance);
+    }
+}
+
+TEST_CASE("SimplifyCurveRepeatedKnots")
+{
+    // Interior Knots 0.3 x 3 And 0.6 x 2, Control Points Perturbed So Removals Are Near The Tolerance. All Removals Of
+    // One Knot Together Must Stay Within It.
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    const std::vector<float> knots = { 0, 0, 0, 0, 0.3f, 0.6f, 1, 1, 1, 1 };
+
+    size_t num_removed = 0;
+    for (size_t trial = 0; trial < 1000; ++trial)
+    {
+        std::vector<glm::vec3> control_points(6);
+        for (glm::vec3& point : control_points)
+        {
+            point = glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+        }
+        auto crv = Refine(tinynurbs::RationalCurve3f(3, knots, control_points, std::vector(6, 1.0f)));
+        REQUIRE(NURBS::RemoveKnot(crv, 0.6f, 1, 1e-5f) == 1);
+
+        const float tolerance = std::pow(10.0f, std::lerp(-3.0f, -1.0f, 0.5f + 0.5f * coordinate(generator)));
+        for (glm::vec3& point : crv.control_points)
+        {
+            point += 0.6f * tolerance * glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+        }
+
+        auto simplified = crv;
+        const auto report = NURBS::Simplify(simplified, tolerance);
+        num_removed += report.knots_removed;
+        CHECK(report.max_deviation <= tolerance);
+        CHECK(CurveDistance(crv, simplified) <= tolerance);
+    }
+    CHECK(num_removed > 0);
+}
+
+TEST_CASE("SimplifySurface")
+{
+    // Biquadratic Patches Over 3 x 2 Spans, Refined To Full Multiplicity In Both Directions.
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 2;
+    srf.degree_v = 2;
+    srf.knots_u = {0, 0, 0, 0.3f, 0.6f, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0.5f, 1, 1, 1};
+    srf.control_points = {5, 4};
+    srf.weights = {5, 4};
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3((float)i, (float)j, std::sin((float)(i + 2 * j)));
+            srf.weights(i, j) = 1.0f + 0.1f * (float)((i + j) % 3);
+        }
+    }
+
+    const auto patches = NURBS::DecomposeBezier<float>(srf);
+    REQUIRE(patches.size() == 6);
+    tinynurbs::RationalSurface3f refined;
+    refined.degree_u = 2;
+    refined.degree_v = 2;
+    refined.knots_u = {0, 0, 0, 0.3f, 0.3f, 0.6f, 0.6f, 1, 1, 1};
+    refined.knots_v = {0, 0, 0, 0.5f, 0.5f, 1, 1, 1};
+    refined.control_points = {7, 5};
+    refined.weights = {7, 5};
+    for (size_t s = 0; s < 3; ++s)
+    {
+        for (size_t r = 0; r < 2; ++r)
+        {
+            for (size_t k = 0; k <= 2; ++k)
+            {
+                for (size_t l = 0; l <= 2; ++l)
+                {
+                    const glm::vec4 point = patches[s * 2 + r][k * 3 + l];
+                    refined.control_points(2 * s + k, 2 * r + l) = glm::vec3(point) / point.w;
+                    refined.weights(2 * s + k, 2 * r + l) = point.w;
+                }
+            }
+        }
+    }
+
+    auto copy = refined;
+    CHECK(NURBS::RemoveKnot(copy, true, 0.3f, 2, 1e-4f) == 1);
+    CHECK(copy.control_points.rows() == 6);
+    CHECK(copy.control_points.cols() == 5);
+
+    std::vector<tinynurbs::RationalCurve3f> curves;
+    std::vector<tinynurbs::RationalSurface3f> surfaces = { refined, srf };
+    const auto report = NURBS::Simplify(curves, surfaces, 1e-4f);
+    CHECK(report.control_points_before == 35 + 20);
+    CHECK(report.control_points_after == 20 + 20);
+    CHECK(report.knots_removed == 3);
+    CHECK(report.max_deviation < 1e-4f);
+    CHECK(surfaces[0].knots_u == srf.knots_u);
+    CHECK(surfaces[0].knots_v == srf.knots_v);
+}
@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file           : TestLODCache.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <LODCache.h>
+#include <tinynurbs/tinynurbs.h>
+
+static tinynurbs::RationalSurface3f Sphere()
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 3;
+    srf.knots_u = {0, 0, 0, 0, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0, 1, 1, 1, 1};
+    // 4x4 grid (tinynurbs::array2) of control points and weights
+    // https://www.geometrictools.com/Documentation/NURBSCircleSphere.pdf
+    srf.control_points = {4, 4, 
+                          {glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1), glm::vec3(0, 0, 1),
+                           glm::vec3(2, 0, 1), glm::vec3(2, 4, 1),  glm::vec3(-2, 4, 1),  glm::vec3(-2, 0, 1),
+                           glm::vec3(2, 0, -1), glm::vec3(2, 4, -1), glm::vec3(-2, 4, -1), glm::vec3(-2, 0, -1),
+                           glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1), glm::vec3(0, 0, -1)
+                          }
+    };
+    srf.weights = {4, 4,
+                   {1,       1.f/3.f, 1.f/3.f, 1,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1.f/3.f, 1.f/9.f, 1.f/9.f, 1.f/3.f,
+                    1,       1.f/3.f, 1.f/3.f, 1
+                   }
+    };
+    return srf;
+}
+
+TEST_CASE("LODCache")
+{
+    const auto srf = Sphere();
+
+    // Errors Shrink With The Level.
+    float previous_error = std::numeric_limits<float>::max();
+    for (size_t level = 0; level <= 4; ++level)
+    {
+        const auto lod = NURBS::TessellateLOD(srf, level);
+        CHECK(lod.resolution == ((size_t)1 << level));
+        CHECK(lod.tiles.size() == 1);
+        CHECK(lod.error < previous_error);
+        previous_error = lod.error;
+    }
+
+    const size_t level_4_bytes = NURBS::TessellateLOD(srf, 4).Bytes();
+    const size_t level_0_bytes = NURBS::TessellateLOD(srf, 0).Bytes();
+
+    // Room For Level 0 And One Level 4.
+    NURBS::LODCache cache(level_0_bytes + level_4_bytes, 4);
+    const size_t id = cache.Add(srf);
+    CHECK(cache.Size() == 1);
+    CHECK(cache.MemoryUsage() == level_0_bytes);
+
+    // A Loose Tolerance Is Met By Level 0.
+    CHECK(cache.Select(id, std::numeric_limits<float>::max())->level == 0);
+
+    // A Tight Tolerance Falls Back To Level 0 While The Finest Level Is Built In The Background.
+    CHECK(cache.Select(id, 0.0f)->level == 0);
+    cache.Wait();
+    const auto finest = cache.Select(id, 0.0f);
+    CHECK(finest->level == 4);
+    CHECK(cache.Error(id, 4) == finest->error);
+
+    // Tolerances Between Levels Settle On A Level Meeting Them Once Its Error Is Measured.
+    const float tolerance = 0.1f;
+    auto selected = cache.Select(id, tolerance);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        cache.Wait();
+        selected = cache.Select(id, tolerance);
+    }
+    CHECK(selected->level < 4);
+    CHECK(selected->error <= tolerance);
+    CHECK(cache.Error(id, selected->level) == selected->error);
+
+    // Level 4 Was Evicted To Stay Within Budget, Yet The Handed Out Pointer Is Still Valid.
+    CHECK(cache.MemoryUsage() <= level_0_bytes + level_4_bytes);
+    CHECK(finest->tiles.front().points.size() == 17 * 17);
+    CHECK(cache.Select(id, 0.0f)->level < 4);
+    cache.Wait();
+    CHECK(cache.Select(id, 0.0f)->level == 4);
+
+    // Projected Tolerance Grows Linearly With Distance.
+    const auto bounding_box = cache.Bounds(id);
+    const float near = NURBS::ScreenSpaceTolerance(bounding_box, glm::vec3(0, 0, 11), 1000.0f, 1.0f);
+    const float far = NURBS::ScreenSpaceTolerance(bounding_box, glm::vec3(0, 0, 21), 1000.0f, 1.0f);
+    CHECK(std::abs(near - 0.01f) < 1e-5f);
+    CHECK(std::abs(far - 0.02f) < 1e-5f);
+}
+
+TEST_CASE("LODCacheSideCamera")
+{
+    // Level 0 Samples Of The Sphere Are Only Its Poles, The Bounds Must Still Contain All Of It.
+    const auto srf = Sphere();
+    NURBS::LODCache cache(std::numeric_limits<size_t>::max(), 2);
+    const size_t id = cache.Add(srf);
+    const auto bounding_box = cache.Bounds(id);
+
+    for (const glm::vec3& eye : { glm::vec3(3, 0, 0), glm::vec3(0, 3, 0), glm::vec3(-3, 1, 0.5f) })
+    {
+        float distance = std::numeric_limits<float>::max();
+        for (size_t a = 0; a <= 32; ++a)
+        {
+            for (size_t b = 0; b <= 32; ++b)
+            {
+                const glm::vec3 point = NURBS::SurfacePoint(srf, (float)a / 32.0f, (float)b / 32.0f);
+                CHECK(glm::distance(glm::clamp(point, bounding_box.min, bounding_box.max), point) < 1e-5f);
+                distance = std::min(distance, glm::distance(eye, point));
+            }
+        }
+        // Never Looser Than The Tolerance At The Nearest Point Of The Surface.
+        CHECK(NURBS::ScreenSpaceTolerance(bounding_box, eye, 1000.0f, 1.0f) <= distance / 1000.0f);
+    }
+}
+
+TEST_CASE("LODCacheNearestMeasuredLevel")
+{
+    NURBS::LODCache cache(std::numeric_limits<size_t>::max(), 6);
+    const size_t id = cache.Add(Sphere());
+
+    // Predicted From Level 0, Level 4 Is The Coarsest Meeting This Tolerance.
+    const float predicted_4 = cache.Error(id, 4);
+    cache.Select(id, predicted_4 * 1.001f);
+    cache.Wait();
+
+    // Only Levels 0 And 4 Are Measured: Level 3 Is Predicted From Level 4.
+    const float error_4 = cache.Error(id, 4);
+    CHECK(error_4 != predicted_4);
+    CHECK(cache.Error(id, 3) == error_4 * 4.0f);
+
+    // Measuring The Finer Level 6 Must Not Make It The Nearest One For Level 3.
+    cache.Select(id, 0.0f);
+    cache.Wait();
+    CHECK(cache.Error(id, 3) == error_4 * 4.0f);
+    CHECK(cache.Error(id, 5) == cache.Error(id, 6) * 4.0f);
+    CHECK(cache.Select(id, 0.0f)->level == 6);
+}
+
+TEST_CASE("LODCacheTinyBudget")
+{
+    const auto srf = Sphere();
+    const size_t level_0_bytes = NURBS::TessellateLOD(srf, 0).Bytes();
+    const size_t level_2_bytes = NURBS::TessellateLOD(srf, 2).Bytes();
+
+    // Level 2 Fits Next To Level 0, Levels 3 And 4 Never Do.
+    NURBS::LODCache cache(level_0_bytes + level_2_bytes, 4);
+    const size_t id = cache.Add(srf);
+    for (size_t frame = 0; frame < 10; ++frame)
+    {
+        cache.Select(id, 0.0f);
+        cache.Wait();
+    }
+    // Levels 4 And 3 Are Built Once Each To Measure Them, Then Level 2 Is Kept.
+    CHECK(cache.NumBuilt() == 3);
+    CHECK(cache.Select(id, 0.0f)->level == 2);
+    CHECK(cache.MemoryUsage() <= level_0_bytes + level_2_bytes);
+    CHECK(cache.Error(id, 4) >= 0.0f);
+
+    for (size_t frame = 0; frame < 10; ++frame)
+    {
+        CHECK(cache.Select(id, 0.0f)->level == 2);
+        cache.Wait();
+    }
+    CHECK(cache.NumBuilt() == 3);
+}
@@ -0,0 +1,226 @@
+/**
+  ******************************************************************************
+  * @file           : TestMesh.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Mesh.h>
+#include <tinynurbs/tinynurbs.h>
+
+#define CHECK_GLM_VERTEX(lhs, rhs) CHECK((glm::distance(lhs, rhs) < 1e-5f))
+
+static tinynurbs::RationalSurface3f Surface()
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 2;
+    srf.knots_u = {0, 0, 0, 0, 0.3f, 0.6f, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0.5f, 1, 1, 1};
+    srf.control_points = {6, 4};
+    srf.weights = {6, 4};
+    for (size_t i = 0; i < 6; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3((float)i, (float)j, std::sin((float)(i + 2 * j)));
+            srf.weights(i, j) = 1.0f + 0.25f * (float)((i * j) % 3);
+        }
+    }
+    return srf;
+}
+
+static tinynurbs::RationalSurface3f Plane(const float x0, const float x1)
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 1;
+    srf.degree_v = 1;
+    srf.knots_u = {0, 0, 1, 1};
+    srf.knots_v = {0, 0, 1, 1};
+    srf.control_points = {2, 2, {glm::vec3(x0, 0, 0), glm::vec3(x0, 1, 0), glm::vec3(x1, 0, 0), glm::vec3(x1, 1, 0)}};
+    srf.weights = {2, 2, {1, 1, 1, 1}};
+    return srf;
+}
+
+TEST_CASE("MeshBuilderSeams")
+{
+    const auto srf = Surface();
+    const size_t resolution = 4;
+
+    // 3 x 2 Tiles, Added In Scrambled Order.
+    std::vector<NURBS::SurfaceTile> tiles;
+    for (const size_t u_span : NURBS::KnotSpans(srf.degree_u, srf.knots_u))
+    {
+        for (const size_t v_span : NURBS::KnotSpans(srf.degree_v, srf.knots_v))
+        {
+            auto& tile = tiles.emplace_back();
+            tile.u_span = u_span;
+            tile.v_span = v_span;
+            tile.resolution = resolution;
+            NURBS::TessellateTile(srf, tile);
+        }
+    }
+    std::ranges::reverse(tiles);
+    std::swap(tiles[1], tiles[4]);
+
+    NURBS::IndexedMesh mesh;
+    size_t num_chunks = 0;
+    NURBS::MeshBuilder builder([&](const NURBS::MeshChunk& chunk) { mesh.Append(chunk); ++num_chunks; }, 0.0f, 20);
+    const size_t surface = builder.AddSurface(srf, resolution);
+    for (const auto& tile : tiles)
+    {
+        builder.AddTile(surface, tile);
+    }
+    builder.Flush();
+
+    CHECK(builder.NumVertices() == 13 * 9);
+    CHECK(builder.NumTriangles() == 2 * 12 * 8);
+    CHECK(builder.NumOpenSeamVertices() == 0);
+    CHECK(num_chunks > 1);
+    REQUIRE(mesh.points.size() == 13 * 9);
+    REQUIRE(mesh.indices.size() == 3 * 2 * 12 * 8);
+
+    // Every Vertex Is Used And Lies On The Surface With Its Normal. Triangles Face Along The Normals.
+    std::vector<bool> used(mesh.points.size(), false);
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        const glm::vec3& p0 = mesh.points[mesh.indices[i]];
+        const glm::vec3& p1 = mesh.points[mesh.indices[i+1]];
+        const glm::vec3& p2 = mesh.points[mesh.indices[i+2]];
+        const glm::vec3 normal = mesh.normals[mesh.indices[i]] + mesh.normals[mesh.indices[i+1]] + mesh.normals[mesh.indices[i+2]];
+        CHECK(glm::dot(glm::cross(p1 - p0, p2 - p0), normal) > 0.0f);
+        used[mesh.indices[i]] = used[mesh.indices[i+1]] = used[mesh.indices[i+2]] = true;
+    }
+    CHECK(std::ranges::all_of(used, [](const bool u) { return u; }));
+
+    std::vector<bool> found(mesh.points.size(), false);
+    for (size_t a = 0; a <= 12; ++a)
+    {
+        for (size_t b = 0; b <= 8; ++b)
+        {
+            const float u = a <= 4 ? 0.3f * (float)a / 4.0f : a <= 8 ? 0.3f + 0.3f * (float)(a - 4) / 4.0f : 0.6f + 0.4f * (float)(a - 8) / 4.0f;
+            const float v = b <= 4 ? 0.5f * (float)b / 4.0f : 0.5f + 0.5f * (float)(b - 4) / 4.0f;
+            const glm::vec3 point = NURBS::SurfacePoint(srf, u, v);
+            for (size_t k = 0; k < mesh.points.size(); ++k)
+            {
+                if (glm::distance(mesh.points[k], point) < 1e-4f)
+                {
+                    CHECK_GLM_VERTEX(mesh.normals[k], NURBS::SurfaceNormal(srf, u, v));
+                    found[k] = true;
+                }
+            }
+        }
+    }
+    CHECK(std::ranges::all_of(found, [](const bool f) { return f; }));
+}
+
+TEST_CASE("MeshBuilderWeld")
+{
+    const size_t resolution = 5;
+
+    for (const float weld_tolerance : { 0.0f, 1e-5f })
+    {
+        NURBS::IndexedMesh mesh;
+        NURBS::MeshBuilder builder([&](const NURBS::MeshChunk& chunk) { mesh.Append(chunk); }, weld_tolerance);
+        builder.Add(Plane(0, 1), resolution);
+        builder.Add(Plane(1, 2), resolution);
+        // Same Edge, Opposite Normal: A Crease Is Not Welded.
+        builder.Add(Plane(2, 1), resolution);
+        builder.Flush();
+
+        const size_t per_surface = (resolution + 1) * (resolution + 1);
+        CHECK(builder.NumVertices() == (weld_tolerance > 0.0f ? 3 * per_surface - (resolution + 1) : 3 * per_surface));
+        CHECK(builder.NumTriangles() == 3 * 2 * resolution * resolution);
+        CHECK(mesh.points.size() == builder.NumVertices());
+    }
+}
+
+TEST_CASE("MeshBuilderWeldWindow")
+{
+    const size_t resolution = 3;
+    const size_t num_surfaces = 200;
+    const size_t weld_window = 4;
+
+    // A Strip Of Planes, Each Welded To The Previous One.
+    NURBS::IndexedMesh mesh;
+    NURBS::MeshBuilder builder([&](const NURBS::MeshChunk& chunk) { mesh.Append(chunk); }, 1e-5f, 64, weld_window);
+    const size_t boundary = 4 * resolution;
+    size_t max_weld_vertices = 0;
+    for (size_t i = 0; i < num_surfaces; ++i)
+    {
+        builder.Add(Plane((float)i, (float)(i + 1)), resolution);
+        max_weld_vertices = std::max(max_weld_vertices, builder.NumWeldVertices());
+    }
+    builder.Flush();
+
+    const size_t per_surface = (resolution + 1) * (resolution + 1);
+    CHECK(builder.NumVertices() == num_surfaces * per_surface - (num_surfaces - 1) * (resolution + 1));
+    CHECK(mesh.points.size() == builder.NumVertices());
+    // Only The Last weld_window Surfaces Keep Their Boundary, However Many Were Added.
+    CHECK(max_weld_vertices <= weld_window * boundary);
+    CHECK(builder.NumWeldVertices() <= weld_window * boundary);
+}
+
+TEST_CASE("PLYWriter")
+{
+    const auto path = std::filesystem::temp_directory_path() / "TestMesh.ply";
+    const auto srf = Surface();
+
+    NURBS::IndexedMesh mesh;
+    {
+        NURBS::PLYWriter writer(path);
+        NURBS::MeshBuilder builder([&](const NURBS::MeshChunk& chunk) { writer.Write(chunk); mesh.Append(chunk); }, 1e-5f, 50);
+        builder.Add(srf, 6);
+        builder.Add(Plane(0, 1), 3);
+        builder.Flush();
+        CHECK(writer.NumVertices() == builder.NumVertices());
+        CHECK(writer.NumFaces() == builder.NumTriangles());
+    }
+    CHECK_FALSE(std::filesystem::exists(path.string() + ".faces"));
+
+    std::ifstream file(path, std::ios::binary);
+    REQUIRE(file);
+    std::string line;
+    size_t num_vertices = 0, num_faces = 0;
+    while (std::getline(file, line) && line != "end_header")
+    {
+        std::istringstream words(line);
+        std::string word, element;
+        words >> word;
+        if (word == "element")
+        {
+            words >> element;
+            (element == "vertex" ? num_vertices : num_faces) = std::stoull(line.substr(line.find(element) + element.size()));
+        }
+    }
+    CHECK(num_vertices == mesh.points.size());
+    CHECK(num_faces * 3 == mesh.indices.size());
+
+    for (size_t i = 0; i < num_vertices; ++i)
+    {
+        std::array<float, 6> vertex{};
+        file.read(reinterpret_cast<char*>(vertex.data()), sizeof(vertex));
+        CHECK(glm::vec3(vertex[0], vertex[1], vertex[2]) == mesh.points[i]);
+        CHECK(glm::vec3(vertex[3], vertex[4], vertex[5]) == mesh.normals[i]);
+    }
+    for (size_t i = 0; i < num_faces; ++i)
+    {
+        unsigned char count = 0;
+        std::array<uint32_t, 3> face{};
+        file.read(reinterpret_cast<char*>(&count), 1);
+        file.read(reinterpret_cast<char*>(face.data()), sizeof(face));
+        CHECK(count == 3);
+        CHECK(std::equal(face.begin(), face.end(), mesh.indices.begin() + 3 * (long long)i));
+    }
+    CHECK(file.peek() == std::char_traits<char>::eof());
+
+    file.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,177 @@
+/**
+  ******************************************************************************
+  * @file           : TestPipeline.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Pipeline.h>
+#include <tinynurbs/tinynurbs.h>
+
+static tinynurbs::RationalSurface3f Surface(const float offset)
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 2;
+    srf.knots_u = {0, 0, 0, 0, 0.3f, 0.6f, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0.5f, 1, 1, 1};
+    srf.control_points = {6, 4};
+    srf.weights = {6, 4};
+    for (size_t i = 0; i < 6; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3((float)i + offset, (float)j, std::sin((float)(i + 2 * j) + offset));
+            srf.weights(i, j) = 1.0f + 0.25f * (float)((i * j) % 3);
+        }
+    }
+    return srf;
+}
+
+TEST_CASE("ChannelBackPressure")
+{
+    NURBS::ThreadPool pool(2);
+    NURBS::Channel<int> channel(pool, 3);
+
+    std::atomic<int> pushed = 0;
+    std::atomic<bool> done = false;
+    std::vector<int> popped;
+
+    const auto producer = [&]() -> NURBS::DetachedTask
+    {
+        co_await pool.Schedule();
+        for (int i = 0; i < 100; ++i)
+        {
+            int value = i;
+            co_await channel.Push(value);
+            ++pushed;
+        }
+        channel.Close();
+    };
+    const auto consumer = [&]() -> NURBS::DetachedTask
+    {
+        co_await pool.Schedule();
+        int value = 0;
+        while (co_await channel.Pop(value))
+        {
+            popped.push_back(value);
+            // Never More Than The Capacity Ahead, Plus The Push In Flight.
+            CHECK(pushed - (int)popped.size() <= 4);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        done = true;
+    };
+
+    producer();
+    consumer();
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(popped == expected);
+}
+
+TEST_CASE("RunPipeline")
+{
+    const size_t num_surfaces = 60;
+    const size_t resolution = 4;
+
+    NURBS::IndexedMesh reference;
+    {
+        NURBS::MeshBuilder builder([&](const NURBS::MeshChunk& chunk) { reference.Append(chunk); });
+        for (size_t i = 0; i < num_surfaces; ++i)
+        {
+            builder.Add(Surface(3.0f * (float)i), resolution);
+        }
+        builder.Flush();
+    }
+
+    for (const size_t num_threads : { 1, 4 })
+    {
+        std::atomic<size_t> loaded = 0;
+        size_t max_ahead = 0;
+        NURBS::IndexedMesh mesh;
+
+        NURBS::PipelineOptions options;
+        options.num_threads = num_threads;
+        options.queue_capacity = 2;
+        options.resolution = resolution;
+        // About One Tile Per Chunk.
+        options.chunk_size = 16;
+
+        const auto statistics = NURBS::RunPipeline(
+            [&]() -> std::optional<tinynurbs::RationalSurface3f>
+            {
+                if (loaded == num_surfaces)
+                {
+                    return std::nullopt;
+                }
+                return Surface(3.0f * (float)loaded++);
+            },
+            [&](const NURBS::MeshChunk& chunk)
+            {
+                // 3 x 2 Tiles Sharing Seams: 13 x 9 Vertices Per Surface.
+                max_ahead = std::max(max_ahead, loaded - mesh.points.size() / (13 * 9));
+                mesh.Append(chunk);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            },
+            options);
+
+        CHECK(statistics.num_surfaces == num_surfaces);
+        CHECK(statistics.num_tiles == 6 * num_surfaces);
+        CHECK(statistics.num_vertices == reference.points.size());
+        CHECK(statistics.num_triangles * 3 == reference.indices.size());
+        CHECK(statistics.first_chunk_seconds <= statistics.total_seconds);
+        CHECK(mesh.points.size() == reference.points.size());
+        CHECK(mesh.indices.size() == reference.indices.size());
+        CHECK(std::ranges::all_of(mesh.indices, [&](const uint32_t index) { return index < mesh.points.size(); }));
+        // Loading Is Throttled By The Slow Writer.
+        CHECK(max_ahead <= 12);
+    }
+}
+
+TEST_CASE("RunPipelineError")
+{
+    size_t loaded = 0;
+    CHECK_THROWS_AS(NURBS::RunPipeline(
+        [&]() -> std::optional<tinynurbs::RationalSurface3f>
+        {
+            if (loaded == 5)
+            {
+                throw std::runtime_error("load");
+            }
+            return Surface((float)loaded++);
+        },
+        [](const NURBS::MeshChunk&) {}), std::runtime_error);
+
+    loaded = 0;
+    size_t written = 0;
+    CHECK_THROWS_AS(NURBS::RunPipeline(
+        [&]() -> std::optional<tinynurbs::RationalSurface3f>
+        {
+            if (loaded == 100)
+            {
+                return std::nullopt;
+            }
+            return Surface((float)loaded++);
+        },
+        [&](const NURBS::MeshChunk&)
+        {
+            if (++written == 3)
+            {
+                throw std::runtime_error("write");
+            }
+        },
+        NURBS::PipelineOptions{ .num_threads = 2, .chunk_size = 8 }), std::runtime_error);
+    CHECK(written == 3);
+}
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file           : TestPowerBasis.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <PowerBasis.h>
+#include <tinynurbs/tinynurbs.h>
+
+#define CHECK_GLM_VERTEX(lhs, rhs) CHECK((glm::distance(lhs, rhs) < 1e-5f))
+
+TEST_CASE("PowerBasisCurve")
+{
+    const tinynurbs::RationalCurve3f crv(
+        3,
+        { 0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f },
+        { glm::vec3(0, 0, 0), glm::vec3(1, 2, 0), glm::vec3(2, 0, 1), glm::vec3(3, 1, 1), glm::vec3(4, 4, 0), glm::vec3(5, 0, 2), glm::vec3(6, 1, 0) },
+        { 1.0f, 2.0f, 0.5f, 1.0f, 3.0f, 1.0f, 1.5f }
+    );
+
+    const auto power_basis_float = NURBS::ToPowerBasis<float>(crv);
+    const auto power_basis_double = NURBS::ToPowerBasis<double>(crv);
+    CHECK(power_basis_float.breakpoints == std::vector{ 0.0f, 0.2f, 0.5f, 1.0f });
+    CHECK(power_basis_float.coefficients.size() == 3 * 4);
+
+    for (const auto u : { 0.0f,0.1f,0.2f,0.3f,0.4f,0.5f,0.6f,0.7f,0.8f,0.9f,1.0f })
+    {
+        CHECK_GLM_VERTEX(NURBS::CurvePoint(power_basis_float, u), NURBS::CurvePoint(crv, u));
+        CHECK_GLM_VERTEX(glm::vec3(NURBS::CurvePoint(power_basis_double, (double)u)), NURBS::CurvePoint(crv, u));
+
+        const auto ders = NURBS::CurveDerivatives(crv, 2, u);
+        const auto power_basis_ders = NURBS::CurveDerivatives(power_basis_double, 2, (double)u);
+        for (size_t k = 0; k <= 2; ++k)
+        {
+            CHECK(glm::distance(glm::vec3(power_basis_ders[k]), ders[k]) < 1e-3f * (1.0f + glm::length(ders[k])));
+        }
+    }
+}
+
+TEST_CASE("PowerBasisSurface")
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 3;
+    srf.degree_v = 2;
+    srf.knots_u = {0, 0, 0, 0, 0.3f, 0.6f, 1, 1, 1, 1};
+    srf.knots_v = {0, 0, 0, 0.5f, 1, 1, 1};
+    srf.control_points = {6, 4};
+    srf.weights = {6, 4};
+    for (size_t i = 0; i < 6; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3((float)i, (float)j, std::cos((float)(i * j)));
+            srf.weights(i, j) = 1.0f + 0.3f * (float)((i * j) % 4);
+        }
+    }
+
+    const auto power_basis_float = NURBS::ToPowerBasis<float>(srf);
+    const auto power_basis_double = NURBS::ToPowerBasis<double>(srf);
+    CHECK(power_basis_float.coefficients.size() == 3 * 2 * 4 * 3);
+
+    for (const auto u : { 0.0f,0.1f,0.2f,0.3f,0.4f,0.5f,0.6f,0.7f,0.8f,0.9f,1.0f })
+    {
+        for (const auto v : { 0.0f,0.1f,0.2f,0.3f,0.4f,0.5f,0.6f,0.7f,0.8f,0.9f,1.0f })
+        {
+            CHECK_GLM_VERTEX(NURBS::SurfacePoint(power_basis_float, u, v), NURBS::SurfacePoint(srf, u, v));
+            CHECK_GLM_VERTEX(glm::vec3(NURBS::SurfacePoint(power_basis_double, (double)u, (double)v)), NURBS::SurfacePoint(srf, u, v));
+            CHECK_GLM_VERTEX(NURBS::SurfaceNormal(power_basis_float, u, v), NURBS::SurfaceNormal(srf, u, v));
+
+            const auto ders = NURBS::SurfaceDerivatives(srf, 2, u, v);
+            const auto power_basis_ders = NURBS::SurfaceDerivatives(power_basis_double, 2, (double)u, (double)v);
+            for (size_t k = 0; k <= 2; ++k)
+            {
+                for (size_t l = 0; k + l <= 2; ++l)
+                {
+                    CHECK(glm::distance(glm::vec3(power_basis_ders[k][l]), ders[k][l]) < 1e-3f * (1.0f + glm::length(ders[k][l])));
+                }
+            }
+            CHECK_GLM_VERTEX(NURBS::SurfaceDerivatives(power_basis_float, 2, u, v)[0][0], NURBS::SurfacePoint(srf, u, v));
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file           : TestSceneEvaluator.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <SceneEvaluator.h>
+#include <tinynurbs/tinynurbs.h>
+
+#define CHECK_GLM_VERTEX(lhs, rhs) CHECK((glm::distance(lhs, rhs) < 1e-5f))
+
+static tinynurbs::RationalCurve3f RandomCurve(std::mt19937& rng, const unsigned int degree, const size_t num_control_points)
+{
+    std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> weight(0.5f, 2.0f);
+
+    tinynurbs::RationalCurve3f crv;
+    crv.degree = degree;
+    crv.knots.assign(degree + 1, 0.0f);
+    for (size_t i = 1; i < num_control_points - degree; ++i)
+    {
+        crv.knots.push_back((float)i);
+    }
+    crv.knots.insert(crv.knots.end(), degree + 1, (float)(num_control_points - degree));
+    for (size_t i = 0; i < num_control_points; ++i)
+    {
+        crv.control_points.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        crv.weights.push_back(weight(rng));
+    }
+    return crv;
+}
+
+TEST_CASE("SceneEvaluator")
+{
+    std::mt19937 rng(26);
+    std::uniform_int_distribution<unsigned int> degree(1, 3);
+    std::uniform_int_distribution<size_t> num_samples(1, 40);
+
+    std::vector<tinynurbs::RationalCurve3f> curves;
+    NURBS::SceneEvaluator scene;
+
+    for (size_t c = 0; c < 2000; ++c)
+    {
+        const unsigned int d = c % 500 == 0 ? 9 : degree(rng);
+        curves.push_back(RandomCurve(rng, d, d + 1 + c % 17));
+        CHECK(scene.Add(curves.back(), num_samples(rng)) == c);
+    }
+
+    CHECK(scene.Size() == curves.size());
+    CHECK(scene.Groups().size() == 4);
+
+    const auto points = scene.Evaluate();
+    CHECK(points.size() == scene.NumSamples());
+
+    for (size_t c = 0; c < curves.size(); ++c)
+    {
+        const auto& crv = curves[c];
+        const float u_min = crv.knots[crv.degree];
+        const float u_max = crv.knots[crv.control_points.size()];
+        const size_t n = scene.Count(c);
+        const float step = n > 1 ? (u_max - u_min) / (float)(n - 1) : 0.0f;
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            const float u = j + 1 == n ? u_max : u_min + (float)j * step;
+            CHECK_GLM_VERTEX(points[scene.Offset(c) + j], NURBS::CurvePoint(crv, u));
+        }
+    }
+
+    // Single Threaded Evaluation Gives The Same Result.
+    std::vector<glm::vec3> serial(scene.NumSamples());
+    scene.Evaluate(serial, 1);
+    CHECK(serial == points);
+}
@@ -0,0 +1,193 @@
+/**
+  ******************************************************************************
+  * @file           : TestTrimming.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#include <doctest/doctest.h>
+#include <NURBS.h>
+#include <Trimming.h>
+#include <tinynurbs/tinynurbs.h>
+
+static NURBS::TrimCurve Line(const glm::vec2& a, const glm::vec2& b)
+{
+    return { 1, { 0, 0, 1, 1 }, { a, b }, { 1, 1 } };
+}
+
+// Rational Quadratic Circle From 4 Quarter Arcs.
+static NURBS::TrimCurve Circle(const glm::vec2& center, const float radius)
+{
+    const float w = std::sqrt(2.0f) / 2.0f;
+    NURBS::TrimCurve crv;
+    crv.degree = 2;
+    crv.knots = { 0, 0, 0, 0.25f, 0.25f, 0.5f, 0.5f, 0.75f, 0.75f, 1, 1, 1 };
+    const std::array<glm::vec2, 9> corners = {
+        glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(-1, 1), glm::vec2(-1, 0),
+        glm::vec2(-1, -1), glm::vec2(0, -1), glm::vec2(1, -1), glm::vec2(1, 0),
+    };
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        crv.control_points.push_back(center + radius * corners[i]);
+        crv.weights.push_back(i % 2 == 1 ? w : 1.0f);
+    }
+    return crv;
+}
+
+// Square [0.1, 0.9]^2 With A Hole Of Radius 0.2 At The Center.
+static std::vector<NURBS::TrimLoop> Loops()
+{
+    const glm::vec2 p0(0.1f, 0.1f), p1(0.9f, 0.1f), p2(0.9f, 0.9f), p3(0.1f, 0.9f);
+    return { { Line(p0, p1), Line(p1, p2), Line(p2, p3), Line(p3, p0) }, { Circle(glm::vec2(0.5f), 0.2f) } };
+}
+
+// Signed Distance To The Boundary Of Loops(), Positive Inside.
+static float Distance(const glm::vec2& uv)
+{
+    const float square = std::min({ uv.x - 0.1f, 0.9f - uv.x, uv.y - 0.1f, 0.9f - uv.y });
+    return std::min(square, glm::distance(uv, glm::vec2(0.5f)) - 0.2f);
+}
+
+// x = u, y = v On [0, 1]^2, Over 2 x 3 Knot Spans.
+static tinynurbs::RationalSurface3f Plane()
+{
+    tinynurbs::RationalSurface3f srf;
+    srf.degree_u = 1;
+    srf.degree_v = 1;
+    srf.knots_u = { 0, 0, 0.4f, 1, 1 };
+    srf.knots_v = { 0, 0, 0.3f, 0.7f, 1, 1 };
+    srf.control_points = {3, 4};
+    srf.weights = {3, 4, 1.0f};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            srf.control_points(i, j) = glm::vec3(srf.knots_u[i+1], srf.knots_v[j+1], 0.0f);
+        }
+    }
+    return srf;
+}
+
+static float Area(const NURBS::MeshChunk& chunk)
+{
+    float area = 0.0f;
+    for (size_t i = 0; i < chunk.indices.size(); i += 3)
+    {
+        const glm::vec3& p0 = chunk.points[chunk.indices[i]];
+        const glm::vec3& p1 = chunk.points[chunk.indices[i+1]];
+        const glm::vec3& p2 = chunk.points[chunk.indices[i+2]];
+        area += 0.5f * glm::length(glm::cross(p1 - p0, p2 - p0));
+    }
+    return area;
+}
+
+TEST_CASE("TrimCurvePoint")
+{
+    const auto circle = Circle(glm::vec2(0.5f, 0.25f), 2.0f);
+    tinynurbs::RationalCurve3f crv;
+    crv.degree = circle.degree;
+    crv.knots = circle.knots;
+    crv.weights = circle.weights;
+    for (const glm::vec2& point : circle.control_points)
+    {
+        crv.control_points.emplace_back(point, 0.0f);
+    }
+
+    for (size_t k = 0; k <= 100; ++k)
+    {
+        const float t = (float)k / 100.0f;
+        const glm::vec2 point = NURBS::TrimCurvePoint(circle, t);
+        CHECK(std::abs(glm::distance(point, glm::vec2(0.5f, 0.25f)) - 2.0f) < 1e-5f);
+        CHECK(glm::distance(glm::vec3(point, 0.0f), NURBS::CurvePoint(crv, t)) < 1e-6f);
+    }
+
+    const auto polyline = NURBS::TrimPolyline(circle, 8);
+    CHECK(polyline.size() == 4 * 8 + 1);
+    CHECK(glm::distance(polyline.front(), polyline.back()) < 1e-6f);
+}
+
+TEST_CASE("TrimRegion")
+{
+    const auto loops = Loops();
+    for (const size_t grid_resolution : { 1, 0, 7, 64 })
+    {
+        const NURBS::TrimRegion region(loops, glm::vec2(0.0f), glm::vec2(1.0f), 16, grid_resolution);
+        CHECK(region.NumSegments() == 4 * 16 + 4 * 16);
+        REQUIRE(region.Polylines().size() == 2);
+        CHECK(region.Polylines()[0].front() == region.Polylines()[0].back());
+
+        // Away From The Boundary, Where The Polylines Agree With The Curves.
+        size_t num_inside = 0;
+        for (size_t a = 0; a <= 101; ++a)
+        {
+            for (size_t b = 0; b <= 101; ++b)
+            {
+                const glm::vec2 uv = glm::vec2(-0.1f) + 1.2f * glm::vec2((float)a, (float)b) / 101.0f;
+                if (std::abs(Distance(uv)) > 2e-3f)
+                {
+                    CHECK(region.Contains(uv) == (Distance(uv) > 0.0f));
+                    num_inside += region.Contains(uv);
+                }
+            }
+        }
+        CHECK(num_inside > 0);
+
+        CHECK(region.Classify(glm::vec2(-1.0f), glm::vec2(-0.5f)) == NURBS::TrimClass::Outside);
+        CHECK(region.Classify(glm::vec2(0.0f), glm::vec2(1.0f)) == NURBS::TrimClass::Boundary);
+        CHECK(region.Classify(glm::vec2(0.0f), glm::vec2(0.5f)) == NURBS::TrimClass::Boundary);
+        if (grid_resolution == 64)
+        {
+            CHECK(region.Classify(glm::vec2(0.0f), glm::vec2(0.05f)) == NURBS::TrimClass::Outside);
+            CHECK(region.Classify(glm::vec2(0.45f), glm::vec2(0.55f)) == NURBS::TrimClass::Outside);
+            CHECK(region.Classify(glm::vec2(0.15f), glm::vec2(0.2f)) == NURBS::TrimClass::Inside);
+        }
+    }
+    CHECK(NURBS::TrimRegion(loops, glm::vec2(0.0f), glm::vec2(1.0f)).GridResolution() == 12);
+}
+
+TEST_CASE("TessellateTrimmed")
+{
+    const size_t resolution = 16;
+
+    const NURBS::TrimmedSurface untrimmed(Plane(), {});
+    CHECK(untrimmed.Contains(0.5f, 0.5f));
+    const auto full = NURBS::TessellateTrimmed(untrimmed, resolution);
+    CHECK(full.indices.size() == 3 * 2 * 6 * resolution * resolution);
+    CHECK(full.points.size() == (2 * resolution + 1) * (3 * resolution + 1));
+    CHECK(std::abs(Area(full) - 1.0f) < 1e-4f);
+
+    const NURBS::TrimmedSurface trimmed(Plane(), Loops());
+    CHECK_FALSE(trimmed.Contains(0.5f, 0.5f));
+    CHECK(trimmed.Contains(0.2f, 0.5f));
+    const auto chunk = NURBS::TessellateTrimmed(trimmed, resolution, 100);
+    CHECK(chunk.first_vertex == 100);
+    REQUIRE(chunk.points.size() == chunk.normals.size());
+    CHECK(std::ranges::all_of(chunk.indices, [&](const uint32_t index) { return index >= 100 && index < 100 + chunk.points.size(); }));
+
+    NURBS::MeshChunk local = chunk;
+    for (uint32_t& index : local.indices)
+    {
+        index -= 100;
+    }
+    // Clipping Follows The Trims Closely, Dropping Whole Triangles Would Not.
+    const float area = 0.8f * 0.8f - std::numbers::pi_v<float> * 0.2f * 0.2f;
+    CHECK(std::abs(Area(local) - area) < 2e-3f);
+    for (size_t i = 0; i < local.points.size(); ++i)
+    {
+        CHECK(Distance(glm::vec2(local.points[i])) > -2e-3f);
+        CHECK(glm::distance(local.normals[i], glm::vec3(0, 0, -1)) < 1e-5f);
+    }
+    // Triangles Face Along The Normals, Clipped Ones Too.
+    for (size_t i = 0; i < local.indices.size(); i += 3)
+    {
+        const glm::vec3& p0 = local.points[local.indices[i]];
+        const glm::vec3& p1 = local.points[local.indices[i+1]];
+        const glm::vec3& p2 = local.points[local.indices[i+2]];
+        CHECK(glm::dot(glm::cross(p1 - p0, p2 - p0), local.normals[local.indices[i]]) > 0.0f);
+    }
+}
@@ -0,0 +1,547 @@
+/**
+  ******************************************************************************
+  * @file           : Trimming.h
+  * @author         : AliceRemake
+  * @brief          : Trimmed Surfaces And Their Tessellation
+  * @attention      : None
+  * @date           : 26-10-19
+  ******************************************************************************
+  */
+
+
+
+#ifndef TRIMMING_H
+#define TRIMMING_H
+
+#include <bits/stdc++.h>
+#include <tinynurbs/tinynurbs.h>
+#include <NURBS.h>
+#include <Tessellation.h>
+#include <Mesh.h>
+
+namespace NURBS
+{
+
+/// @brief Rational Curve In The (u, v) Parameter Domain Of A Surface.
+struct TrimCurve
+{
+    size_t degree = 0;
+    std::vector<float> knots;
+    std::vector<glm::vec2> control_points;
+    std::vector<float> weights;
+};
+
+/// @brief Closed Loop Of Trim Curves, Each Starting Where The Previous One Ends.
+using TrimLoop = std::vector<TrimCurve>;
+
+/// @brief Same As CurvePoint, In The Parameter Domain.
+inline glm::vec2 TrimCurvePoint(EvaluationContext& context, const TrimCurve& crv, const float t)
+{
+    const size_t span = FindSpan(crv.degree, crv.knots, t);
+
+    const auto b_spline_basis = EvaluationContext::Acquire(context.u_b_spline_basis, crv.degree + 1);
+    BSplineBasis(context, crv.degree, span, crv.knots, t, b_spline_basis);
+
+    glm::vec3 point(0.0f);
+
+    for (size_t i = 0; i < b_spline_basis.size(); ++i)
+    {
+        const size_t index = span - crv.degree + i;
+        point += b_spline_basis[i] * glm::vec3(crv.control_points[index] * crv.weights[index], crv.weights[index]);
+    }
+
+    return glm::vec2(point) / point.z;
+}
+
+inline glm::vec2 TrimCurvePoint(const TrimCurve& crv, const float t)
+{
+    EvaluationContext context;
+    return TrimCurvePoint(context, crv, t);
+}
+
+/// @brief samples_per_span Segments Per Nonempty Knot Span, From The Start To The End Of crv.
+inline std::vector<glm::vec2> TrimPolyline(const TrimCurve& crv, const size_t samples_per_span)
+{
+    assert(samples_per_span > 0);
+    assert(crv.knots.size() == crv.control_points.size() + crv.degree + 1);
+
+    EvaluationContext context;
+    const auto spans = KnotSpans(crv.degree, crv.knots);
+    std::vector<glm::vec2> polyline;
+    polyline.reserve(spans.size() * samples_per_span + 1);
+    for (const size_t span : spans)
+    {
+        const float t_min = crv.knots[span], t_max = crv.knots[span+1];
+        for (size_t k = 0; k < samples_per_span; ++k)
+        {
+            polyline.push_back(TrimCurvePoint(context, crv, t_min + (float)k / (float)samples_per_span * (t_max - t_min)));
+        }
+    }
+    polyline.push_back(TrimCurvePoint(context, crv, crv.knots[crv.knots.size() - crv.degree - 1]));
+    return polyline;
+}
+
+enum class TrimClass
+{
+    Outside,
+    Inside,
+    Boundary,
+};
+
+/// @brief Inside / Outside Tests Against Trim Loops, Accelerated By A Uniform Grid In (u, v).
+///
+/// Loops Are Approximated By Closed Polylines Once. A Point Is Inside If It Is Enclosed By An Odd Number Of Loops
+/// (Even-Odd Rule), So An Outer Loop With Holes Works Whatever The Orientation Of The Loops.
+///
+/// The Grid Covers The Domain And Every Loop. Each Cell Stores The Segments Overlapping It And Whether Its Center Is
+/// Inside, Found Once By Walking Every Row Of Centers. Cells Without Segments Are Entirely Inside Or Outside; In The
+/// Others A Point Flips The State Of The Center Once Per Segment Crossing The Line Between Them, And Only Segments Of
+/// The Cell Can Cross It. Contains Is Thread Safe.
+///
+class TrimRegion
+{
+public:
+    /// @param grid_resolution Cells Per Side, 0 Means About sqrt(Number Of Segments).
+    TrimRegion(const std::span<const TrimLoop> loops, const glm::vec2& domain_min, const glm::vec2& domain_max,
+               const size_t samples_per_span = 16, size_t grid_resolution = 0)
+    {
+        box_min_ = domain_min;
+        box_max_ = domain_max;
+        for (const TrimLoop& loop : loops)
+        {
+            auto& polyline = polylines_.emplace_back();
+            for (const TrimCurve& crv : loop)
+            {
+                const auto points = TrimPolyline(crv, samples_per_span);
+                // Consecutive Curves Share Their End Points.
+                const bool joined = !polyline.empty() && polyline.back() == points.front();
+                polyline.insert(polyline.end(), points.begin() + (joined ? 1 : 0), points.end());
+            }
+            if (!polyline.empty() && polyline.back() != polyline.front())
+            {
+                polyline.push_back(polyline.front());
+            }
+            for (size_t i = 0; i + 1 < polyline.size(); ++i)
+            {
+                segments_.push_back({ polyline[i], polyline[i+1] });
+                box_min_ = glm::min(box_min_, polyline[i]);
+                box_max_ = glm::max(box_max_, polyline[i]);
+            }
+        }
+
+        // A Margin Keeps Every Segment Strictly Inside, So The Left Side Of The Box Is Outside.
+        const float extent = std::max(box_max_.x - box_min_.x, box_max_.y - box_min_.y);
+        const float margin = extent > 0.0f ? 1e-3f * extent : 1.0f;
+        box_min_ -= glm::vec2(margin);
+        box_max_ += glm::vec2(margin);
+
+        if (grid_resolution == 0)
+        {
+            grid_resolution = std::clamp((size_t)std::ceil(std::sqrt((double)segments_.size())), (size_t)1, (size_t)1024);
+        }
+        resolution_ = grid_resolution;
+        cell_size_ = (box_max_ - box_min_) / (float)resolution_;
+
+        // Segments Of Every Cell Overlapped By Their Bounding Box, In Compressed Rows.
+        offsets_.assign(resolution_ * resolution_ + 1, 0);
+        for (const Segment& segment : segments_)
+        {
+            ForEachCell(segment, [&](const size_t cell) { ++offsets_[cell+1]; });
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+        cell_segments_.resize(offsets_.back());
+        std::vector<size_t> fill(offsets_.begin(), offsets_.end() - 1);
+        for (uint32_t s = 0; s < segments_.size(); ++s)
+        {
+            ForEachCell(segments_[s], [&](const size_t cell) { cell_segments_[fill[cell]++] = s; });
+        }
+
+        cells_.resize(resolution_ * resolution_);
+        center_inside_.resize(resolution_ * resolution_);
+        for (size_t j = 0; j < resolution_; ++j)
+        {
+            glm::vec2 previous(box_min_.x, Center(0, j).y);
+            bool inside = false;
+            for (size_t i = 0; i < resolution_; ++i)
+            {
+                const size_t cell = j * resolution_ + i;
+                const glm::vec2 center = Center(i, j);
+                // The Step From The Previous Center Only Crosses Segments Of This Cell And The Previous One. Those
+                // In Both Are Counted With The Previous One.
+                size_t crossings = Crossings(previous, center, cell, i);
+                if (i > 0)
+                {
+                    crossings += Crossings(previous, center, cell - 1, 0);
+                }
+                inside = inside != (crossings % 2 == 1);
+                center_inside_[cell] = inside;
+                cells_[cell] = offsets_[cell] != offsets_[cell+1] ? TrimClass::Boundary : inside ? TrimClass::Inside : TrimClass::Outside;
+                previous = center;
+            }
+        }
+    }
+
+    [[nodiscard]] bool Contains(const glm::vec2& uv) const noexcept
+    {
+        if (uv.x < box_min_.x || uv.y < box_min_.y || uv.x > box_max_.x || uv.y > box_max_.y)
+        {
+            return false;
+        }
+        const size_t i = CellIndex(uv.x, 0), j = CellIndex(uv.y, 1);
+        const size_t cell = j * resolution_ + i;
+        if (cells_[cell] != TrimClass::Boundary)
+        {
+            return cells_[cell] == TrimClass::Inside;
+        }
+        return center_inside_[cell] != (Crossings(uv, Center(i, j), cell, 0) % 2 == 1);
+    }
+
+    /// @brief Class Of The Rectangle [uv_min, uv_max]. Boundary Is Conservative: It May Still Be All In Or All Out.
+    [[nodiscard]] TrimClass Classify(const glm::vec2& uv_min, const glm::vec2& uv_max) const noexcept
+    {
+        if (uv_max.x < box_min_.x || uv_max.y < box_min_.y || uv_min.x > box_max_.x || uv_min.y > box_max_.y)
+        {
+            return TrimClass::Outside;
+        }
+        const bool clipped = uv_min.x < box_min_.x || uv_min.y < box_min_.y || uv_max.x > box_max_.x || uv_max.y > box_max_.y;
+        const size_t i_min = CellIndex(uv_min.x, 0), i_max = CellIndex(uv_max.x, 0);
+        const size_t j_min = CellIndex(uv_min.y, 1), j_max = CellIndex(uv_max.y, 1);
+        const TrimClass first = clipped ? TrimClass::Outside : cells_[j_min * resolution_ + i_min];
+        for (size_t j = j_min; j <= j_max; ++j)
+        {
+            for (size_t i = i_min; i <= i_max; ++i)
+            {
+                if (cells_[j * resolution_ + i] != first || first == TrimClass::Boundary)
+                {
+                    return TrimClass::Boundary;
+                }
+            }
+        }
+        return first;
+    }
+
+    /// @brief The Closed Polyline Of Every Loop, Last Point Equal To The First.
+    [[nodiscard]] const std::vector<std::vector<glm::vec2>>& Polylines() const noexcept
+    {
+        return polylines_;
+    }
+
+    [[nodiscard]] size_t NumSegments() const noexcept
+    {
+        return segments_.size();
+    }
+
+    [[nodiscard]] size_t GridResolution() const noexcept
+    {
+        return resolution_;
+    }
+
+private:
+    struct Segment
+    {
+        glm::vec2 a;
+        glm::vec2 b;
+    };
+
+    // Floor Of The Cell Coordinate, Clamped. Monotone, So A Point Between Two Others Lies In A Cell Between Theirs.
+    [[nodiscard]] size_t CellIndex(const float x, const size_t axis) const noexcept
+    {
+        return (size_t)std::clamp((x - box_min_[(int)axis]) / cell_size_[(int)axis], 0.0f, (float)(resolution_ - 1));
+    }
+
+    [[nodiscard]] glm::vec2 Center(const size_t i, const size_t j) const noexcept
+    {
+        return box_min_ + glm::vec2((float)i + 0.5f, (float)j + 0.5f) * cell_size_;
+    }
+
+    template <typename Function>
+    void ForEachCell(const Segment& segment, Function&& function) const
+    {
+        const glm::vec2 lo = glm::min(segment.a, segment.b), hi = glm::max(segment.a, segment.b);
+        for (size_t j = CellIndex(lo.y, 1); j <= CellIndex(hi.y, 1); ++j)
+        {
+            for (size_t i = CellIndex(lo.x, 0); i <= CellIndex(hi.x, 0); ++i)
+            {
+                function(j * resolution_ + i);
+            }
+        }
+    }
+
+    // Sign Of The Area Of (a, b, c). Zero Counts As Negative, As If c Was Moved Off The Line: Both Segments At A
+    // Shared Vertex See It On The Same Side, So Passing Exactly Through A Vertex Is Counted Consistently.
+    static bool Positive(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) noexcept
+    {
+        return ((double)b.x - a.x) * ((double)c.y - a.y) - ((double)b.y - a.y) * ((double)c.x - a.x) > 0.0;
+    }
+
+    // Segments Of cell Crossing [p, q], Skipping Those Whose First Column Is Before skip_before.
+    [[nodiscard]] size_t Crossings(const glm::vec2& p, const glm::vec2& q, const size_t cell, const size_t skip_before) const noexcept
+    {
+        size_t crossings = 0;
+        for (size_t k = offsets_[cell]; k < offsets_[cell+1]; ++k)
+        {
+            const Segment& segment = segments_[cell_segments_[k]];
+            if (skip_before > 0 && CellIndex(std::min(segment.a.x, segment.b.x), 0) < skip_before)
+            {
+                continue;
+            }
+            if (Positive(segment.a, segment.b, p) != Positive(segment.a, segment.b, q) &&
+                Positive(p, q, segment.a) != Positive(p, q, segment.b))
+            {
+                ++crossings;
+            }
+        }
+        return crossings;
+    }
+
+    std::vector<std::vector<glm::vec2>> polylines_;
+    std::vector<Segment> segments_;
+    glm::vec2 box_min_;
+    glm::vec2 box_max_;
+    glm::vec2 cell_size_;
+    size_t resolution_ = 1;
+    std::vector<size_t> offsets_;
+    std::vector<uint32_t> cell_segments_;
+    std::vector<TrimClass> cells_;
+    std::vector<bool> center_inside_;
+};
+
+/// @brief A Surface Restricted To The Region Of Its Trim Loops. Without Loops The Whole Surface Is Kept.
+class TrimmedSurface
+{
+public:
+    TrimmedSurface(tinynurbs::RationalSurface<float> srf, std::vector<TrimLoop> loops,
+                   const size_t samples_per_span = 16, const size_t grid_resolution = 0)
+        : surface_(std::move(srf)), loops_(std::move(loops)),
+          region_(loops_, DomainMin(surface_), DomainMax(surface_), samples_per_span, grid_resolution)
+    {}
+
+    [[nodiscard]] bool Contains(const float u, const float v) const noexcept
+    {
+        return loops_.empty() || region_.Contains(glm::vec2(u, v));
+    }
+
+    [[nodiscard]] TrimClass Classify(const glm::vec2& uv_min, const glm::vec2& uv_max) const noexcept
+    {
+        return loops_.empty() ? TrimClass::Inside : region_.Classify(uv_min, uv_max);
+    }
+
+    [[nodiscard]] const tinynurbs::RationalSurface<float>& Surface() const noexcept
+    {
+        return surface_;
+    }
+
+    [[nodiscard]] const std::vector<TrimLoop>& Loops() const noexcept
+    {
+        return loops_;
+    }
+
+    [[nodiscard]] const TrimRegion& Region() const noexcept
+    {
+        return region_;
+    }
+
+    static glm::vec2 DomainMin(const tinynurbs::RationalSurface<float>& srf) noexcept
+    {
+        return { srf.knots_u[srf.degree_u], srf.knots_v[srf.degree_v] };
+    }
+
+    static glm::vec2 DomainMax(const tinynurbs::RationalSurface<float>& srf) noexcept
+    {
+        return { srf.knots_u[srf.knots_u.size() - srf.degree_u - 1], srf.knots_v[srf.knots_v.size() - srf.degree_v - 1] };
+    }
+
+private:
+    tinynurbs::RationalSurface<float> surface_;
+    std::vector<TrimLoop> loops_;
+    TrimRegion region_;
+};
+
+/// @brief Tessellate The Kept Part Of trimmed On The Same Grid As TessellateTile, As One Chunk Whose Vertices Start
+/// At first_vertex.
+///
+/// Tiles Entirely Outside Are Never Evaluated, Tiles Entirely Inside Skip The Inside Tests. Triangles
+/// (v00, v01, v11), (v00, v11, v10) Are Kept If All Corners Are Inside And Dropped If None Is; The Others Are Clipped
+/// At The Trim Boundary Found By Bisection On Their Edges, Shared With The Neighbouring Triangle. Trim Features
+/// Smaller Than A Grid Cell May Be Missed.
+///
+inline MeshChunk TessellateTrimmed(const TrimmedSurface& trimmed, const size_t resolution, const uint32_t first_vertex = 0)
+{
+    assert(resolution > 0);
+
+    // Bisect Down To About float Precision Along An Edge.
+    constexpr size_t Bisections = 24;
+    constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+    const auto& srf = trimmed.Surface();
+    const auto u_spans = KnotSpans(srf.degree_u, srf.knots_u);
+    const auto v_spans = KnotSpans(srf.degree_v, srf.knots_v);
+    const size_t grid_u = u_spans.size() * resolution + 1;
+    const size_t grid_v = v_spans.size() * resolution + 1;
+
+    // Parameters Of The Grid Lines. Consecutive Nonempty Spans Share Their End Knot.
+    std::vector<float> us(grid_u), vs(grid_v);
+    for (size_t s = 0; s < u_spans.size(); ++s)
+    {
+        const float u_min = srf.knots_u[u_spans[s]], u_max = srf.knots_u[u_spans[s]+1];
+        for (size_t a = 0; a <= resolution; ++a)
+        {
+            us[s * resolution + a] = u_min + (float)a / (float)resolution * (u_max - u_min);
+        }
+    }
+    for (size_t r = 0; r < v_spans.size(); ++r)
+    {
+        const float v_min = srf.knots_v[v_spans[r]], v_max = srf.knots_v[v_spans[r]+1];
+        for (size_t b = 0; b <= resolution; ++b)
+        {
+            vs[r * resolution + b] = v_min + (float)b / (float)resolution * (v_max - v_min);
+        }
+    }
+
+    MeshChunk chunk;
+    chunk.first_vertex = first_vertex;
+
+    // -1 Not Evaluated, Otherwise 0 Outside / 1 Inside.
+    std::vector<signed char> inside(grid_u * grid_v, -1);
+    std::vector<glm::vec3> points(grid_u * grid_v), normals(grid_u * grid_v);
+    std::vector<uint32_t> indices(grid_u * grid_v, None);
+    std::unordered_map<uint64_t, uint32_t> crossings;
+    EvaluationContext context;
+
+    const auto grid_vertex = [&](const size_t g) -> uint32_t
+    {
+        if (indices[g] == None)
+        {
+            indices[g] = first_vertex + (uint32_t)chunk.points.size();
+            chunk.points.push_back(points[g]);
+            chunk.normals.push_back(normals[g]);
+        }
+        return indices[g];
+    };
+
+    const auto crossing_vertex = [&](const size_t g_in, const size_t g_out) -> uint32_t
+    {
+        const uint64_t key = (uint64_t)std::min(g_in, g_out) * grid_u * grid_v + std::max(g_in, g_out);
+        if (const auto it = crossings.find(key); it != crossings.end())
+        {
+            return it->second;
+        }
+        const glm::vec2 corner_in(us[g_in / grid_v], vs[g_in % grid_v]);
+        const glm::vec2 corner_out(us[g_out / grid_v], vs[g_out % grid_v]);
+        glm::vec2 uv_in = corner_in, uv_out = corner_out;
+        for (size_t k = 0; k < Bisections; ++k)
+        {
+            const glm::vec2 mid = 0.5f * (uv_in + uv_out);
+            (trimmed.Contains(mid.x, mid.y) ? uv_in : uv_out) = mid;
+        }
+        // A Corner Lies On The Trim: Reuse It, So The Collapsed Triangles Are Dropped.
+        uint32_t index = 0;
+        if (uv_in == corner_in)
+        {
+            index = grid_vertex(g_in);
+        }
+        else if (uv_out == corner_out)
+        {
+            index = grid_vertex(g_out);
+        }
+        else
+        {
+            index = first_vertex + (uint32_t)chunk.points.size();
+            chunk.points.push_back(SurfacePoint(context, srf, uv_in.x, uv_in.y));
+            chunk.normals.push_back(SurfaceNormal(context, srf, uv_in.x, uv_in.y));
+        }
+        crossings.emplace(key, index);
+        return index;
+    };
+
+    const auto add_triangle = [&](const uint32_t v0, const uint32_t v1, const uint32_t v2)
+    {
+        if (v0 != v1 && v1 != v2 && v2 != v0)
+        {
+            chunk.indices.insert(chunk.indices.end(), { v0, v1, v2 });
+        }
+    };
+
+    SurfaceTile tile;
+    tile.resolution = resolution;
+    const size_t samples = resolution + 1;
+
+    for (size_t s = 0; s < u_spans.size(); ++s)
+    {
+        for (size_t r = 0; r < v_spans.size(); ++r)
+        {
+            const glm::vec2 uv_min(srf.knots_u[u_spans[s]], srf.knots_v[v_spans[r]]);
+            const glm::vec2 uv_max(srf.knots_u[u_spans[s]+1], srf.knots_v[v_spans[r]+1]);
+            const TrimClass tile_class = trimmed.Classify(uv_min, uv_max);
+            if (tile_class == TrimClass::Outside)
+            {
+                continue;
+            }
+
+            tile.u_span = u_spans[s];
+            tile.v_span = v_spans[r];
+            TessellateTile(srf, tile);
+
+            for (size_t a = 0; a < samples; ++a)
+            {
+                for (size_t b = 0; b < samples; ++b)
+                {
+                    const size_t g = (s * resolution + a) * grid_v + r * resolution + b;
+                    if (inside[g] == -1 || tile_class == TrimClass::Inside)
+                    {
+                        points[g] = tile.points[a * samples + b];
+                        normals[g] = tile.normals[a * samples + b];
+                        inside[g] = tile_class == TrimClass::Inside || trimmed.Contains(us[g / grid_v], vs[g % grid_v]);
+                    }
+                }
+            }
+
+            for (size_t a = 0; a < resolution; ++a)
+            {
+                for (size_t b = 0; b < resolution; ++b)
+                {
+                    const size_t g00 = (s * resolution + a) * grid_v + r * resolution + b;
+                    const size_t g01 = g00 + 1, g10 = g00 + grid_v, g11 = g10 + 1;
+                    for (const std::array<size_t, 3> corners : { std::array{ g00, g01, g11 }, std::array{ g00, g11, g10 } })
+                    {
+                        const size_t num_inside = (size_t)inside[corners[0]] + (size_t)inside[corners[1]] + (size_t)inside[corners[2]];
+                        if (num_inside == 0)
+                        {
+                            continue;
+                        }
+                        if (num_inside == 3)
+                        {
+                            add_triangle(grid_vertex(corners[0]), grid_vertex(corners[1]), grid_vertex(corners[2]));
+                            continue;
+                        }
+                        // Walk The Edges In Order, So The Clipped Polygon (3 Or 4 Corners) Keeps The Orientation.
+                        std::array<uint32_t, 4> polygon{};
+                        size_t size = 0;
+                        for (size_t k = 0; k < 3; ++k)
+                        {
+                            const size_t g0 = corners[k], g1 = corners[(k+1)%3];
+                            if (inside[g0])
+                            {
+                                polygon[size++] = grid_vertex(g0);
+                            }
+                            if (inside[g0] != inside[g1])
+                            {
+                                polygon[size++] = inside[g0] ? crossing_vertex(g0, g1) : crossing_vertex(g1, g0);
+                            }
+                        }
+                        for (size_t k = 1; k + 1 < size; ++k)
+                        {
+                            add_triangle(polygon[0], polygon[k], polygon[k+1]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return chunk;
+}
+
+}
+
+#endif //TRIMMING_H